@@ -0,0 +1,346 @@
+#include "config_io.hpp"
+#include "core/option_value.hpp"
+#include "core/section_tree.hpp"
+#include "core/value_codec.hpp"
+#include "platform/hyprland_backend.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+// Keeps the optimiser from discarding results.
+volatile size_t g_sink = 0;
+
+struct Result {
+    std::string name;
+    size_t samples = 0;
+    size_t ops_per_sample = 0;
+    double min_ns = 0.0;
+    double median_ns = 0.0;
+    double mean_ns = 0.0;
+    size_t bytes = 0;
+};
+
+class Suite {
+public:
+    explicit Suite(std::string filter) : m_filter(std::move(filter)) {}
+
+    bool enabled(const std::string& name) const {
+        return m_filter.empty() || name.find(m_filter) != std::string::npos;
+    }
+
+    // Times `samples` runs of `ops` calls to `body`, calling `setup` untimed
+    // before each run. Reported times are per call.
+    void run(const std::string& name, size_t samples, size_t ops,
+             const std::function<void()>& setup, const std::function<void()>& body,
+             size_t bytes = 0) {
+        if (!enabled(name)) {
+            return;
+        }
+
+        std::vector<double> perOp;
+        perOp.reserve(samples);
+        for (size_t sample = 0; sample < samples; ++sample) {
+            if (setup) {
+                setup();
+            }
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t op = 0; op < ops; ++op) {
+                body();
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            perOp.push_back(std::chrono::duration<double, std::nano>(elapsed).count() /
+                            static_cast<double>(ops));
+        }
+
+        std::sort(perOp.begin(), perOp.end());
+        Result result;
+        result.name = name;
+        result.samples = samples;
+        result.ops_per_sample = ops;
+        result.min_ns = perOp.front();
+        result.median_ns = perOp[perOp.size() / 2];
+        result.mean_ns = std::accumulate(perOp.begin(), perOp.end(), 0.0) / static_cast<double>(perOp.size());
+        result.bytes = bytes;
+        m_results.push_back(result);
+        std::cerr << name << ": " << result.median_ns << " ns/op\n";
+    }
+
+    void write_json(std::ostream& out) const {
+        out << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const auto& result = m_results[i];
+            out << "    {\"name\": \"" << result.name << "\""
+                << ", \"samples\": " << result.samples
+                << ", \"ops_per_sample\": " << result.ops_per_sample
+                << ", \"min_ns\": " << result.min_ns
+                << ", \"median_ns\": " << result.median_ns
+                << ", \"mean_ns\": " << result.mean_ns
+                << ", \"bytes\": " << result.bytes << "}"
+                << (i + 1 < m_results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+private:
+    std::string m_filter;
+    std::vector<Result> m_results;
+};
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+// A `hyprctl descriptions -j` payload cycling through every option type.
+std::string synthetic_descriptions(size_t count) {
+    std::ostringstream json;
+    json << "[";
+    for (size_t i = 0; i < count; ++i) {
+        const int type = static_cast<int>(i % 9);
+        json << (i == 0 ? "" : ",") << "{\"value\": \"section" << (i % 97) << ":sub" << (i % 7)
+             << ":option" << i << "\", \"description\": \"synthetic option " << i
+             << " used to measure description parsing\", \"type\": " << type
+             << ", \"flags\": 0, \"data\": {";
+        switch (type) {
+        case 0:
+            json << "\"value\": false, \"current\": true, \"explicit\": true";
+            break;
+        case 1:
+            json << "\"value\": 1, \"min\": 0, \"max\": 20, \"current\": " << (i % 20) << ", \"explicit\": false";
+            break;
+        case 2:
+            json << "\"value\": 0.5, \"min\": 0.0, \"max\": 1.0, \"current\": 0.25, \"explicit\": false";
+            break;
+        case 5:
+            json << "\"value\": 4294967295, \"current\": 4281545523, \"explicit\": false";
+            break;
+        case 6:
+            json << "\"value\": \"none,slide,popin,fade\", \"current\": 2, \"explicit\": false";
+            break;
+        case 7:
+            json << "\"value\": \"0xffaabbcc 0xff112233 45deg\", "
+                    "\"current\": \"0xffaabbcc 0xff112233 45deg\", \"explicit\": false";
+            break;
+        case 8:
+            json << "\"value\": \"0, 0\", \"min_x\": 0, \"min_y\": 0, \"max_x\": 100, \"max_y\": 100, "
+                    "\"current\": \"10, 20\", \"explicit\": false";
+            break;
+        default:
+            json << "\"value\": \"[[EMPTY]]\", \"current\": \"text value\", \"explicit\": false";
+            break;
+        }
+        json << "}}";
+    }
+    json << "]";
+    return json.str();
+}
+
+// Config blocks of plausible option lines, at least `bytes` long.
+std::string synthetic_config(size_t bytes) {
+    std::string config;
+    config.reserve(bytes + 256);
+    size_t block = 0;
+    while (config.size() < bytes) {
+        config += "section" + std::to_string(block % 97) + " {\n";
+        for (size_t line = 0; line < 8; ++line) {
+            config += "    option" + std::to_string(line) + " = " + std::to_string(block * 8 + line) + "\n";
+        }
+        config += "}\n\n";
+        ++block;
+    }
+    return config;
+}
+
+// Mirrors the tree the snapshot prefetch builds for the sidebar.
+void build_section_tree(const SettingsSnapshot& snapshot) {
+    core::SectionTree tree;
+    core::SectionNode& variables = tree.add_child(tree.root(), "Variables", "__variables__");
+    for (const auto& sectionPath : snapshot.sections) {
+        if (!sectionPath.empty()) {
+            tree.insert_path(variables, sectionPath);
+        }
+    }
+    for (const auto& option : snapshot.options) {
+        tree.add_option(option.section_path);
+    }
+    g_sink = g_sink + tree.root().children.size();
+}
+
+using NamedSnapshots = std::vector<std::pair<std::string, SettingsSnapshot>>;
+
+void bench_descriptions(Suite& suite, const std::string& descriptionsPath, NamedSnapshots& snapshots) {
+    if (!descriptionsPath.empty()) {
+        const std::string json = read_file(descriptionsPath);
+        if (json.empty()) {
+            std::cerr << "Could not read " << descriptionsPath << '\n';
+        } else {
+            suite.run("descriptions/parse/test.txt", 20, 1, nullptr, [&json]() {
+                g_sink = g_sink + hyprland::parse_descriptions_json(json).options.size();
+            }, json.size());
+            snapshots.emplace_back("test.txt", hyprland::parse_descriptions_json(json));
+        }
+    }
+
+    for (size_t count : {size_t{1000}, size_t{10000}, size_t{50000}}) {
+        const std::string json = synthetic_descriptions(count);
+        const std::string label = "synthetic-" + std::to_string(count);
+        suite.run("descriptions/parse/" + label, count >= 50000 ? 3 : 10, 1, nullptr, [&json]() {
+            g_sink = g_sink + hyprland::parse_descriptions_json(json).options.size();
+        }, json.size());
+        snapshots.emplace_back(label, hyprland::parse_descriptions_json(json));
+    }
+}
+
+void bench_config_io(Suite& suite) {
+    namespace fs = std::filesystem;
+    const fs::path path = fs::temp_directory_path() / "hyprland-settings-bench.conf";
+
+    const std::pair<const char*, size_t> sizes[] = {
+        {"1KB", 1024},
+        {"100KB", 100 * 1024},
+        {"1MB", 1024 * 1024},
+        {"10MB", 10 * 1024 * 1024},
+    };
+    for (const auto& size : sizes) {
+        const std::string config = synthetic_config(size.second);
+        const size_t samples = size.second >= 10 * 1024 * 1024 ? 3 : (size.second >= 1024 * 1024 ? 10 : 50);
+        // The file is rewritten before every sample so each update sees the
+        // same input.
+        suite.run(std::string("config-io/update-option/") + size.first, samples, 1,
+                  [&]() {
+                      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                      out << config;
+                  },
+                  [&]() {
+                      g_sink = g_sink + ConfigIO::updateOption(path.string(), "general:border_size", "2");
+                  },
+                  config.size());
+    }
+
+    std::error_code ignored;
+    fs::remove(path, ignored);
+}
+
+template <core::ValueType T>
+void bench_value_type(Suite& suite, const char* name, const std::vector<std::string>& inputs) {
+    using Traits = core::ValueTraits<T>;
+    const std::string prefix = std::string("values/") + name + "/";
+    constexpr size_t kSamples = 30;
+    constexpr size_t kOps = 10000;
+
+    std::vector<core::OptionValue> decoded;
+    for (const auto& input : inputs) {
+        decoded.push_back(core::OptionValue::decode(T, input));
+    }
+
+    size_t i = 0;
+    suite.run(prefix + "parse", kSamples, kOps, nullptr, [&]() {
+        g_sink = g_sink + Traits::parse(inputs[i++ % inputs.size()]).has_value();
+    });
+    suite.run(prefix + "normalize", kSamples, kOps, nullptr, [&]() {
+        auto normalized = Traits::normalize(inputs[i++ % inputs.size()]);
+        g_sink = g_sink + (normalized ? normalized->size() : 0);
+    });
+    suite.run(prefix + "normalize-dispatched", kSamples, kOps, nullptr, [&]() {
+        auto normalized = core::normalize_value(T, inputs[i++ % inputs.size()]);
+        g_sink = g_sink + (normalized ? normalized->size() : 0);
+    });
+    suite.run(prefix + "decode", kSamples, kOps, nullptr, [&]() {
+        g_sink = g_sink + core::OptionValue::decode(T, inputs[i++ % inputs.size()]).str().size();
+    });
+    // Decoded equality is what decides whether an edit has to be sent.
+    suite.run(prefix + "equal", kSamples, kOps, nullptr, [&]() {
+        const size_t at = i++;
+        g_sink = g_sink + (decoded[at % decoded.size()] == decoded[(at + 1) % decoded.size()]);
+    });
+}
+
+void bench_values(Suite& suite) {
+    bench_value_type<core::ValueType::Bool>(suite, "bool", {"true", "false", "1", "0", " yes "});
+    bench_value_type<core::ValueType::Int>(suite, "int", {"0", "2", "-15", "1024", "3.7"});
+    bench_value_type<core::ValueType::Float>(suite, "float", {"0.5", "1.000000", "-0.25", "12.75", "1e-3"});
+    bench_value_type<core::ValueType::String>(suite, "string",
+                                              {"us", "  JetBrains   Mono ", "[[EMPTY]]", "caps:escape"});
+    bench_value_type<core::ValueType::LongString>(suite, "long-string", {"kitty", "[[EMPTY]]", "a b  c"});
+    bench_value_type<core::ValueType::Color>(suite, "color", {"0xFF33CCFF", "#aabbcc", "4294967295", "AABBCC"});
+    bench_value_type<core::ValueType::Choice>(suite, "choice", {"0", "1", "2"});
+    bench_value_type<core::ValueType::Gradient>(suite, "gradient",
+                                                {"0xffaabbcc 0xff112233 45deg",
+                                                 "rgba(33ccffee)  rgba(00ff99ee) 45deg"});
+    bench_value_type<core::ValueType::Vec2>(suite, "vec2", {"1, 2", "0.5 0.5", "-3,4", "10 20"});
+
+    const std::vector<std::string> colors = {"0xFF33CCFF", "#aabbcc", "4294967295", "AABBCC", "nope"};
+    size_t i = 0;
+    suite.run("normalizers/color", 30, 10000, nullptr, [&]() {
+        auto normalized = core::normalize_color_value(colors[i++ % colors.size()]);
+        g_sink = g_sink + (normalized ? normalized->size() : 0);
+    });
+
+    const std::vector<std::string> vectors = {"1, 2", "0.5 0.5", "-3,4", "10 20", "1 2 3"};
+    suite.run("normalizers/vector", 30, 10000, nullptr, [&]() {
+        auto vector = core::parse_vector_value(vectors[i++ % vectors.size()]);
+        if (vector.has_value()) {
+            g_sink = g_sink + core::format_vector_value(vector->first, vector->second, false).size();
+        }
+    });
+}
+
+void bench_section_tree(Suite& suite, const NamedSnapshots& snapshots) {
+    for (const auto& snapshot : snapshots) {
+        const size_t samples = snapshot.second.options.size() >= 50000 ? 5 : 20;
+        suite.run("section-tree/build/" + snapshot.first, samples, 1, nullptr,
+                  [&snapshot]() { build_section_tree(snapshot.second); });
+    }
+}
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--descriptions FILE] [--filter TEXT] [--output FILE]\n";
+}
+}
+
+int main(int argc, char** argv) {
+    std::string descriptionsPath;
+    std::string filter;
+    std::string outputPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 < argc && arg == "--descriptions") {
+            descriptionsPath = argv[++i];
+        } else if (i + 1 < argc && arg == "--filter") {
+            filter = argv[++i];
+        } else if (i + 1 < argc && arg == "--output") {
+            outputPath = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    Suite suite(filter);
+    NamedSnapshots snapshots;
+    bench_descriptions(suite, descriptionsPath, snapshots);
+    bench_config_io(suite);
+    bench_values(suite);
+    bench_section_tree(suite, snapshots);
+
+    // Progress goes to stderr; stdout carries only the JSON report.
+    if (outputPath.empty()) {
+        suite.write_json(std::cout);
+    } else {
+        std::ofstream out(outputPath);
+        suite.write_json(out);
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include "core/models.hpp"
+#include "platform/hyprland_backend.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+void print_usage(const char* argv0) {
+    std::cerr << "usage: " << argv0 << " [--runtime-only] <command> [args]\n"
+              << "\n"
+              << "  get NAME...          print the current value of each option\n"
+              << "  set NAME=VALUE...    apply the options and save them to the config\n"
+              << "  apply-file FILE      like set, with one \"NAME = VALUE\" per line ('-' reads stdin)\n"
+              << "  export [--all]       print options set in the config (or all of them) as an\n"
+              << "                       apply-file\n"
+              << "\n"
+              << "  --runtime-only       apply without writing the config file\n";
+}
+
+std::string trim(const std::string& text) {
+    const size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    const size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool parse_assignment(const std::string& text, OptionAssignments& out) {
+    const size_t equals = text.find('=');
+    if (equals == std::string::npos) {
+        return false;
+    }
+    std::string name = trim(text.substr(0, equals));
+    if (name.empty()) {
+        return false;
+    }
+    out.emplace_back(std::move(name), trim(text.substr(equals + 1)));
+    return true;
+}
+
+bool read_assignments(std::istream& in, const std::string& source, OptionAssignments& out) {
+    std::string line;
+    size_t number = 0;
+    while (std::getline(in, line)) {
+        ++number;
+        const std::string content = trim(line);
+        if (content.empty() || content[0] == '#') {
+            continue;
+        }
+        if (!parse_assignment(content, out)) {
+            std::cerr << source << ":" << number << ": expected NAME = VALUE\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int apply(const HyprlandBackend& backend, const OptionAssignments& options, bool runtimeOnly) {
+    if (options.empty()) {
+        return 0;
+    }
+
+    std::vector<std::string> failed;
+    const bool ok = runtimeOnly ? backend.apply_runtime_options(options, &failed)
+                                : backend.apply_persistent_options(options, &failed);
+    for (const auto& name : failed) {
+        std::cerr << "failed: " << name << '\n';
+    }
+    return ok ? 0 : 1;
+}
+
+int run_get(const HyprlandBackend& backend, const std::vector<std::string>& names) {
+    // One batch of getoption queries rather than every description.
+    const std::vector<OptionState> states = backend.refresh_options(names);
+    std::unordered_map<std::string, const OptionState*> byName;
+    byName.reserve(states.size());
+    for (const auto& state : states) {
+        byName.emplace(state.name, &state);
+    }
+
+    int status = 0;
+    for (const auto& name : names) {
+        auto state = byName.find(name);
+        if (state == byName.end()) {
+            std::cerr << "unknown option: " << name << '\n';
+            status = 1;
+            continue;
+        }
+        std::cout << name << " = " << state->second->value << '\n';
+    }
+    return status;
+}
+
+int run_export(const HyprlandBackend& backend, bool all) {
+    const SettingsSnapshot snapshot = backend.load_options();
+    if (snapshot.options.empty()) {
+        std::cerr << "could not read options from Hyprland\n";
+        return 1;
+    }
+    for (const auto& option : snapshot.options) {
+        if (all || option.set_by_user) {
+            std::cout << option.name << " = " << option.value << '\n';
+        }
+    }
+    return 0;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    bool runtimeOnly = false;
+    if (!args.empty() && args[0] == "--runtime-only") {
+        runtimeOnly = true;
+        args.erase(args.begin());
+    }
+    if (args.empty() || args[0] == "--help" || args[0] == "-h") {
+        print_usage(argv[0]);
+        return args.empty() ? 2 : 0;
+    }
+
+    const std::string command = args[0];
+    args.erase(args.begin());
+    HyprlandBackend backend;
+
+    if (command == "get" && !args.empty()) {
+        return run_get(backend, args);
+    }
+
+    if (command == "set" && !args.empty()) {
+        OptionAssignments options;
+        for (const auto& arg : args) {
+            if (!parse_assignment(arg, options)) {
+                std::cerr << "expected NAME=VALUE, got: " << arg << '\n';
+                return 2;
+            }
+        }
+        return apply(backend, options, runtimeOnly);
+    }
+
+    if (command == "apply-file" && args.size() == 1) {
+        OptionAssignments options;
+        if (args[0] == "-") {
+            if (!read_assignments(std::cin, "<stdin>", options)) {
+                return 2;
+            }
+        } else {
+            std::ifstream in(args[0]);
+            if (!in.is_open()) {
+                std::cerr << "could not open " << args[0] << '\n';
+                return 2;
+            }
+            if (!read_assignments(in, args[0], options)) {
+                return 2;
+            }
+        }
+        return apply(backend, options, runtimeOnly);
+    }
+
+    if (command == "export" && (args.empty() || (args.size() == 1 && args[0] == "--all"))) {
+        return run_export(backend, !args.empty());
+    }
+
+    print_usage(argv[0]);
+    return 2;
+}
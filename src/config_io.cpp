@@ -1,8 +1,12 @@
 #include "config_io.hpp"
 
+#include "core/trace.hpp"
+
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unordered_set>
 #include <vector>
 
 namespace {
@@ -18,50 +22,230 @@ std::vector<std::string> split_path(const std::string& path) {
     }
     return parts;
 }
-}  // namespace
 
-bool ConfigIO::updateOption(const std::string& filePath, const std::string& optionPath, const std::string& value) {
+std::string trim(const std::string& text) {
+    const size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    const size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+// The line without a trailing "# comment". Hyprland writes a literal '#' in a
+// value as "##", which is kept.
+std::string strip_comment(const std::string& text) {
+    size_t pos = text.find('#');
+    while (pos != std::string::npos && pos + 1 < text.size() && text[pos + 1] == '#') {
+        pos = text.find('#', pos + 2);
+    }
+    return trim(text.substr(0, pos));
+}
+
+// Writes next to the real file (through a symlinked dotfile) and renames over
+// it, so Hyprland's file watcher and a crash mid-write never see half a config.
+bool write_atomically(const std::string& filePath, const std::vector<std::string>& lines) {
+    std::error_code ec;
+    std::filesystem::path target = std::filesystem::weakly_canonical(filePath, ec);
+    if (ec) {
+        target = filePath;
+    }
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+
+    {
+        std::ofstream outFile(temp, std::ios::trunc);
+        if (!outFile.is_open()) {
+            return false;
+        }
+        for (const auto& l : lines) {
+            outFile << l << '\n';
+        }
+        if (!outFile.flush()) {
+            outFile.close();
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+
+    const auto permissions = std::filesystem::status(target, ec).permissions();
+    if (!ec) {
+        std::filesystem::permissions(temp, permissions, ec);
+    }
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+bool read_lines(const std::string& filePath, std::vector<std::string>& lines) {
     std::ifstream inFile(filePath);
     if (!inFile.is_open()) {
         std::cerr << "Could not open config file for reading: " << filePath << '\n';
         return false;
     }
 
-    std::vector<std::string> lines;
     std::string line;
     while (std::getline(inFile, line)) {
         lines.push_back(line);
     }
-    inFile.close();
+    return true;
+}
+
+// Appends each option at the end, wrapped in its section blocks.
+bool append_options(std::vector<std::string>& lines,
+                    const std::vector<std::pair<std::string, std::string>>& options) {
+    for (const auto& option : options) {
+        auto parts = split_path(option.first);
+        if (parts.empty()) {
+            return false;
+        }
+
+        std::string key = parts.back();
+        parts.pop_back(); // Remove key, remaining are sections
+        // parts is now ["section", "subsection"]
+
+        // Simply append the option to the end of the file
+        std::string indent = "";
+        for (const auto& part : parts) {
+            lines.push_back(indent + part + " {");
+            indent += "    ";
+        }
+        lines.push_back(indent + key + " = " + option.second);
+        for (size_t i = 0; i < parts.size(); ++i) {
+            indent = indent.substr(0, indent.length() - 4);
+            lines.push_back(indent + "}");
+        }
+    }
+    return true;
+}
+
+// Drops every assignment of the options in place. Returns whether any was
+// found.
+bool remove_options(std::vector<std::string>& lines, const std::vector<std::string>& optionPaths) {
+    struct Block {
+        size_t open;
+        std::string name;
+        bool removed = false;
+        bool empty = true;
+        // Comment and blank lines directly inside the block, dropped with it.
+        std::vector<size_t> filler;
+    };
+
+    const std::unordered_set<std::string> names(optionPaths.begin(), optionPaths.end());
+    std::vector<bool> keep(lines.size(), true);
+    std::vector<Block> blocks;
+    bool removedAny = false;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const std::string content = strip_comment(lines[i]);
+        if (content.empty()) {
+            if (!blocks.empty()) {
+                blocks.back().filler.push_back(i);
+            }
+            continue;
+        }
+
+        if (content.back() == '{') {
+            blocks.push_back({i, trim(content.substr(0, content.size() - 1))});
+            continue;
+        }
+
+        if (content == "}") {
+            if (blocks.empty()) {
+                continue;
+            }
+            const Block block = blocks.back();
+            blocks.pop_back();
+            if (block.removed && block.empty) {
+                keep[block.open] = false;
+                keep[i] = false;
+                for (size_t filler : block.filler) {
+                    keep[filler] = false;
+                }
+            }
+            if (!blocks.empty()) {
+                blocks.back().removed = blocks.back().removed || block.removed;
+                blocks.back().empty = blocks.back().empty && block.removed && block.empty;
+            }
+            continue;
+        }
+
+        const size_t equals = content.find('=');
+        std::string path;
+        if (equals != std::string::npos) {
+            for (const auto& block : blocks) {
+                path += block.name + ":";
+            }
+            path += trim(content.substr(0, equals));
+        }
+        if (!path.empty() && names.count(path) > 0) {
+            keep[i] = false;
+            removedAny = true;
+            if (!blocks.empty()) {
+                blocks.back().removed = true;
+            }
+        } else if (!blocks.empty()) {
+            blocks.back().empty = false;
+        }
+    }
 
-    auto parts = split_path(optionPath);
-    if (parts.empty()) {
+    if (!removedAny) {
         return false;
     }
 
-    std::string key = parts.back();
-    parts.pop_back(); // Remove key, remaining are sections
-    // parts is now ["section", "subsection"]
+    std::vector<std::string> kept;
+    kept.reserve(lines.size());
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (keep[i]) {
+            kept.push_back(std::move(lines[i]));
+        }
+    }
+    lines = std::move(kept);
+    return true;
+}
+}  // namespace
+
+bool ConfigIO::updateOption(const std::string& filePath, const std::string& optionPath, const std::string& value) {
+    return updateOptions(filePath, {{optionPath, value}});
+}
+
+bool ConfigIO::updateOptions(const std::string& filePath,
+                             const std::vector<std::pair<std::string, std::string>>& options) {
+    HYPRLAND_TRACE_SPAN_DETAIL("config_io.update_options", options.size() == 1 ? options[0].first : "");
+    std::vector<std::string> lines;
+    if (!read_lines(filePath, lines) || !append_options(lines, options)) {
+        return false;
+    }
+    return write_atomically(filePath, lines);
+}
 
-    // Simply append the option to the end of the file
-    std::string indent = "";
-    for (const auto& part : parts) {
-        lines.push_back(indent + part + " {");
-        indent += "    ";
+bool ConfigIO::removeOptions(const std::string& filePath, const std::vector<std::string>& optionPaths) {
+    HYPRLAND_TRACE_SPAN("config_io.remove_options");
+    std::vector<std::string> lines;
+    if (!read_lines(filePath, lines)) {
+        return false;
     }
-    lines.push_back(indent + key + " = " + value);
-    for (size_t i = 0; i < parts.size(); ++i) {
-        indent = indent.substr(0, indent.length() - 4);
-        lines.push_back(indent + "}");
+    if (!remove_options(lines, optionPaths)) {
+        return true;
     }
+    return write_atomically(filePath, lines);
+}
 
-    // Write the updated content back to the file
-    std::ofstream outFile(filePath);
-    if (!outFile.is_open()) {
+bool ConfigIO::applyOptions(const std::string& filePath,
+                            const std::vector<std::pair<std::string, std::string>>& options,
+                            const std::vector<std::string>& removedPaths) {
+    HYPRLAND_TRACE_SPAN("config_io.apply_options");
+    std::vector<std::string> lines;
+    if (!read_lines(filePath, lines)) {
+        return false;
+    }
+    const bool removed = remove_options(lines, removedPaths);
+    if (!append_options(lines, options)) {
         return false;
     }
-    for (const auto& l : lines) {
-        outFile << l << '\n';
+    if (!removed && options.empty()) {
+        return true;
     }
-    return true;
+    return write_atomically(filePath, lines);
 }
@@ -2,10 +2,24 @@
 #define CONFIG_IO_HPP
 
 #include <string>
+#include <utility>
+#include <vector>
 
 class ConfigIO {
 public:
     static bool updateOption(const std::string& filePath, const std::string& optionPath, const std::string& value);
+    // Appends every option and replaces the file in one atomic write.
+    static bool updateOptions(const std::string& filePath,
+                              const std::vector<std::pair<std::string, std::string>>& options);
+    // Drops every assignment of the options, in either the nested or the
+    // "section:key" form, along with blocks left empty and the comments
+    // inside them. One atomic write, or none when nothing matched.
+    static bool removeOptions(const std::string& filePath, const std::vector<std::string>& optionPaths);
+    // removeOptions for removedPaths, then updateOptions for options, in one
+    // atomic write.
+    static bool applyOptions(const std::string& filePath,
+                             const std::vector<std::pair<std::string, std::string>>& options,
+                             const std::vector<std::string>& removedPaths);
 };
 
 #endif // CONFIG_IO_HPP
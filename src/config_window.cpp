@@ -1,20 +1,32 @@
 #include "config_window.hpp"
 
+#include "core/event_ring.hpp"
 #include "features/navigation_feature.hpp"
 #include "ui/devices_panel.hpp"
+#include "ui/diagnostics_page.hpp"
+#include "ui/facet_bar.hpp"
 #include "ui/keywords_panel.hpp"
+#include "ui/metrics_page.hpp"
+#include "ui/profiles_menu.hpp"
+#include "ui/staged_changes_bar.hpp"
+#include "ui/section_sidebar.hpp"
+#include "ui/section_slot.hpp"
 #include "ui/variables_panel.hpp"
 
 #include <filesystem>
 #include <iostream>
+#include <memory>
 #include <gtkmm/settings.h>
 
-ConfigWindow::ConfigWindow()
+ConfigWindow::ConfigWindow(features::StartupBenchmark* startupBenchmark)
 : m_MainVBox(Gtk::Orientation::VERTICAL),
   m_MenuBox(Gtk::Orientation::VERTICAL),
   m_ContentBox(Gtk::Orientation::VERTICAL),
   m_HBox(Gtk::Orientation::HORIZONTAL),
-  m_ContentVBox(Gtk::Orientation::VERTICAL)
+  m_ContentVBox(Gtk::Orientation::VERTICAL),
+  m_Prefetch(m_SettingsController),
+  m_OptionRefresh(m_SettingsController),
+  m_StartupBenchmark(startupBenchmark)
 {
     // Force Adwaita theme to avoid system theme interference
     auto settings = Gtk::Settings::get_default();
@@ -40,6 +52,28 @@ ConfigWindow::ConfigWindow()
     m_Button_Refresh.signal_clicked().connect(sigc::mem_fun(*this, &ConfigWindow::on_button_refresh));
     m_HeaderBar.pack_start(m_Button_Refresh);
 
+    auto* metrics_button = Gtk::make_managed<Gtk::Button>();
+    metrics_button->set_icon_name("utilities-system-monitor-symbolic");
+    metrics_button->set_tooltip_text("Backend Metrics");
+    metrics_button->signal_clicked().connect([this]() {
+        m_MainStack.set_visible_child("metrics");
+    });
+    m_HeaderBar.pack_end(*metrics_button);
+
+    m_ProfilesMenu = std::make_unique<ui::ProfilesMenu>(
+        [this]() { return m_ProfileStore.names(); },
+        [this](const std::string& name) { apply_profile(name); },
+        [this](const std::string& name) { save_profile(name); },
+        [this](const std::string& name) { remove_profile(name); },
+        [this]() { reset_all_options(); });
+    m_HeaderBar.pack_end(*m_ProfilesMenu->widget());
+
+    m_StagedBar = std::make_unique<ui::StagedChangesBar>(
+        [this](bool staging) { set_staging(staging); },
+        [this]() { apply_staged_changes(); },
+        [this]() { discard_staged_changes(); });
+    m_HeaderBar.pack_end(*m_StagedBar->widget());
+
     set_child(m_MainVBox);
 
     auto css_provider = Gtk::CssProvider::create();
@@ -77,19 +111,27 @@ ConfigWindow::ConfigWindow()
     m_HBox.set_expand(true);
     m_ContentBox.append(m_HBox);
 
-    m_SectionTreeStore = Gtk::TreeStore::create(m_SectionColumns);
-    m_TreeView.set_model(m_SectionTreeStore);
-    m_TreeView.append_column("Section", m_SectionColumns.m_col_name);
-    m_TreeView.set_headers_visible(false);
-    m_TreeView.get_selection()->signal_changed().connect(sigc::mem_fun(*this, &ConfigWindow::on_section_selected));
-    m_TreeView.add_css_class("sidebar");
+    m_Sidebar = std::make_unique<ui::SectionSidebar>(
+        [this](const std::string& sectionPath) { on_section_selected(sectionPath); },
+        [this](const std::string& sectionPath) { reset_section(sectionPath); });
+
+    auto sidebarBox = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
+    sidebarBox->set_size_request(240, -1);
+
+    m_SearchEntry.set_placeholder_text("Search options...");
+    m_SearchEntry.set_margin(6);
+    m_SearchEntry.signal_search_changed().connect(sigc::mem_fun(*this, &ConfigWindow::on_search_changed));
+    sidebarBox->append(m_SearchEntry);
 
     auto sidebarScroll = Gtk::make_managed<Gtk::ScrolledWindow>();
-    sidebarScroll->set_child(m_TreeView);
+    sidebarScroll->set_child(*m_Sidebar->widget());
     sidebarScroll->set_policy(Gtk::PolicyType::NEVER, Gtk::PolicyType::AUTOMATIC);
-    sidebarScroll->set_size_request(240, -1);
+    sidebarScroll->set_vexpand(true);
     sidebarScroll->add_css_class("sidebar-scroll");
-    m_HBox.append(*sidebarScroll);
+    sidebarBox->append(*sidebarScroll);
+    m_HBox.append(*sidebarBox);
+
+    m_OptionFilter = Gtk::CustomFilter::create(sigc::mem_fun(*this, &ConfigWindow::option_matches_filter));
 
     m_ContentScroll.set_expand(true);
     m_ContentScroll.set_policy(Gtk::PolicyType::AUTOMATIC, Gtk::PolicyType::AUTOMATIC);
@@ -100,10 +142,48 @@ ConfigWindow::ConfigWindow()
     auto v_adj = m_ContentScroll.get_vadjustment();
     if (v_adj) {
         v_adj->signal_value_changed().connect(sigc::mem_fun(*this, &ConfigWindow::on_scroll_changed));
+        v_adj->signal_changed().connect(sigc::mem_fun(*this, &ConfigWindow::queue_realized_sections_update));
     }
 
-    m_HBox.append(m_ContentScroll);
+    m_FacetBar = std::make_unique<ui::FacetBar>([this]() { on_facets_changed(); });
+
+    auto contentColumn = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
+    contentColumn->set_hexpand(true);
+    contentColumn->append(*m_FacetBar->widget());
+    contentColumn->append(m_ContentScroll);
+    m_HBox.append(*contentColumn);
     m_MainStack.add(m_ContentBox, "content", "Settings");
+
+    m_MetricsPage = std::make_unique<ui::MetricsPage>();
+    auto metricsScroll = Gtk::make_managed<Gtk::ScrolledWindow>();
+    metricsScroll->set_child(*m_MetricsPage->widget());
+    m_MainStack.add(*metricsScroll, "metrics", "Metrics");
+
+    // Deliberately has no button; Ctrl+Shift+D opens it.
+    m_DiagnosticsPage = std::make_unique<ui::DiagnosticsPage>([this]() { return diagnostics_stats(); });
+    m_MainStack.add(*m_DiagnosticsPage->widget(), "diagnostics", "Diagnostics");
+
+    auto shortcuts = Gtk::ShortcutController::create();
+    shortcuts->set_scope(Gtk::ShortcutScope::GLOBAL);
+    shortcuts->add_shortcut(Gtk::Shortcut::create(
+        Gtk::ShortcutTrigger::parse_string("<Control><Shift>d"),
+        Gtk::CallbackAction::create([this](Gtk::Widget&, const Glib::VariantBase&) {
+            toggle_diagnostics_page();
+            return true;
+        })));
+    shortcuts->add_shortcut(Gtk::Shortcut::create(
+        Gtk::ShortcutTrigger::parse_string("<Control>z"),
+        Gtk::CallbackAction::create([this](Gtk::Widget&, const Glib::VariantBase&) {
+            undo_last_change();
+            return true;
+        })));
+    shortcuts->add_shortcut(Gtk::Shortcut::create(
+        Gtk::ShortcutTrigger::parse_string("<Control><Shift>z"),
+        Gtk::CallbackAction::create([this](Gtk::Widget&, const Glib::VariantBase&) {
+            redo_last_change();
+            return true;
+        })));
+    add_controller(shortcuts);
     m_StatusLabel.set_halign(Gtk::Align::START);
     m_StatusLabel.set_margin_start(12);
     m_StatusLabel.set_margin_end(12);
@@ -116,6 +196,72 @@ ConfigWindow::ConfigWindow()
     m_DeviceConfigStore = Gio::ListStore<DeviceConfigItem>::create();
 
     m_MainStack.set_visible_child("menu");
+    m_MainStack.property_visible_child_name().signal_changed().connect(
+        sigc::mem_fun(*this, &ConfigWindow::on_main_page_changed));
+
+    // Coming back to the window is the likeliest moment for options to have
+    // changed elsewhere; re-read only the sections on screen. Focus bounces
+    // while switching windows, so wait until it settles.
+    property_is_active().signal_changed().connect([this]() {
+        m_FocusRefresh.disconnect();
+        if (!is_active() || m_MainStack.get_visible_child_name() != "content") {
+            return;
+        }
+        m_FocusRefresh = Glib::signal_timeout().connect(
+            [this]() {
+                refresh_realized_sections();
+                return false;
+            },
+            300);
+    });
+
+    // Fetch and parse the snapshot while the main menu is up; the Hyprland
+    // button then only has to attach the result.
+    m_Prefetch.start();
+
+    if (m_StartupBenchmark) {
+        m_StartupBenchmark->mark("window_constructed");
+        run_startup_benchmark();
+    }
+}
+
+ConfigWindow::~ConfigWindow() {
+    m_RealizeIdle.disconnect();
+    m_StartupPaint.disconnect();
+    m_FocusRefresh.disconnect();
+    m_RefreshPoll.disconnect();
+}
+
+void ConfigWindow::run_startup_benchmark() {
+    // A sliding transition would make "first frame" a frame of the animation.
+    m_MainStack.set_transition_type(Gtk::StackTransitionType::NONE);
+
+    add_tick_callback([this](const Glib::RefPtr<Gdk::FrameClock>&) {
+        m_StartupBenchmark->mark("menu_first_frame");
+        Glib::signal_idle().connect_once([this]() {
+            m_StartupBenchmark->mark("click");
+            on_hyprland_button_clicked();
+            m_StartupBenchmark->mark("content_shown");
+
+            auto clock = get_frame_clock();
+            if (!clock) {
+                finish_startup_benchmark();
+                return;
+            }
+            m_StartupPaint = clock->signal_after_paint().connect(
+                sigc::mem_fun(*this, &ConfigWindow::finish_startup_benchmark));
+            queue_draw();
+        });
+        return false;
+    });
+}
+
+void ConfigWindow::finish_startup_benchmark() {
+    m_StartupPaint.disconnect();
+    m_StartupBenchmark->mark("first_frame");
+    m_StartupBenchmark->set_option_count(m_Snapshot.options.size());
+    std::cout << m_StartupBenchmark->to_json() << std::flush;
+    close();
 }
 
 void ConfigWindow::on_hyprland_button_clicked() {
@@ -123,25 +269,119 @@ void ConfigWindow::on_hyprland_button_clicked() {
     m_MainStack.set_visible_child("content");
 }
 
-void ConfigWindow::on_section_selected() {
+void ConfigWindow::on_section_selected(const std::string& sectionPath) {
+    if (m_selecting_programmatically) {
+        return;
+    }
+
+    const bool populated = populate_sections_through(sectionPath);
+    const bool realized = realize_section(sectionPath);
+    if (populated || realized) {
+        // Content changed above or at the target, so its offset is only known
+        // once the next frame has been laid out.
+        run_after_layout([this, sectionPath]() { scroll_to_section(sectionPath); });
+        return;
+    }
+
+    scroll_to_section(sectionPath);
+}
+
+void ConfigWindow::run_after_layout(const std::function<void()>& callback) {
+    auto frames = std::make_shared<int>(0);
+    add_tick_callback([callback, frames](const Glib::RefPtr<Gdk::FrameClock>&) {
+        if ((*frames)++ == 0) {
+            return true;
+        }
+        callback();
+        return false;
+    });
+}
+
+void ConfigWindow::scroll_to_section(const std::string& sectionPath) {
     features::handle_section_selected(
         m_selecting_programmatically,
         m_scrolling_programmatically,
-        m_TreeView,
-        m_SectionColumns.m_col_full_path,
+        sectionPath,
         m_SectionWidgets,
         m_ContentVBox,
         m_ContentScroll);
 }
 
+void ConfigWindow::on_main_page_changed() {
+    if (m_MainStack.get_visible_child_name() == "content") {
+        realize_first_page();
+        queue_realized_sections_update();
+    } else if (m_MainStack.get_visible_child_name() == "menu") {
+        // Debug pages keep the panels so their counts describe the content.
+        evict_all_sections();
+    }
+}
+
+void ConfigWindow::toggle_diagnostics_page() {
+    const std::string current = m_MainStack.get_visible_child_name();
+    if (current == "diagnostics") {
+        m_MainStack.set_visible_child(m_PageBeforeDiagnostics.empty() ? "menu" : m_PageBeforeDiagnostics);
+        return;
+    }
+    m_PageBeforeDiagnostics = current;
+    m_MainStack.set_visible_child("diagnostics");
+}
+
+std::vector<std::pair<std::string, size_t>> ConfigWindow::diagnostics_stats() const {
+    size_t widgets = 0;
+    std::vector<const Gtk::Widget*> pending{&m_ContentVBox};
+    while (!pending.empty()) {
+        const Gtk::Widget* widget = pending.back();
+        pending.pop_back();
+        ++widgets;
+        for (auto child = widget->get_first_child(); child; child = child->get_next_sibling()) {
+            pending.push_back(child);
+        }
+    }
+
+    size_t rows = 0;
+    for (const auto& store : m_SectionStores) {
+        rows += store.second->get_n_items();
+    }
+
+    size_t realized = 0;
+    for (const auto& slot : m_SectionSlots) {
+        realized += slot.second->is_realized() ? 1 : 0;
+    }
+
+    return {
+        {"content widgets", widgets},
+        {"realized sections", realized},
+        {"section slots", m_SectionSlots.size()},
+        {"section stores", m_SectionStores.size()},
+        {"option rows in stores", rows},
+        {"sections left to populate", m_PendingSections.size()},
+        {"executing keywords", m_ExecutingStore->get_n_items()},
+        {"environment variables", m_EnvVarStore->get_n_items()},
+        {"device configs", m_DeviceConfigStore->get_n_items()},
+        {"events logged", static_cast<size_t>(core::event_ring().head())},
+    };
+}
+
+void ConfigWindow::queue_realized_sections_update() {
+    // Adjustment changes arrive during allocation; building panels there would
+    // resize the content mid-layout, so defer to the next idle.
+    if (m_RealizeIdle.connected()) {
+        return;
+    }
+    m_RealizeIdle = Glib::signal_idle().connect([this]() {
+        update_realized_sections();
+        return false;
+    });
+}
+
 void ConfigWindow::on_scroll_changed() {
+    update_realized_sections();
     features::handle_scroll_changed(
         m_scrolling_programmatically,
         m_selecting_programmatically,
         m_OrderedSections,
-        m_SectionIters,
-        m_TreeView,
-        m_SectionTreeStore,
+        [this](const std::string& sectionPath) { m_Sidebar->select(sectionPath); },
         m_ContentVBox,
         m_ContentScroll);
 }
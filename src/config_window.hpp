@@ -1,11 +1,25 @@
 #ifndef CONFIG_WINDOW_HPP
 #define CONFIG_WINDOW_HPP
 
+#include "core/description_index.hpp"
+#include "core/option_bitset.hpp"
+#include "core/option_search_index.hpp"
+#include "core/option_value.hpp"
+#include "core/section_tree.hpp"
+#include "features/device_schema.hpp"
+#include "features/edit_history.hpp"
+#include "features/option_facets.hpp"
+#include "features/option_refresh.hpp"
+#include "features/profiles.hpp"
 #include "features/settings_controller.hpp"
+#include "features/snapshot_prefetch.hpp"
+#include "features/startup_benchmark.hpp"
 #include "ui/item_models.hpp"
 
 #include <gtkmm.h>
 
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -17,6 +31,13 @@ namespace ui {
 class VariablesPanel;
 class KeywordsPanel;
 class DevicesPanel;
+class SectionSidebar;
+class SectionSlot;
+class FacetBar;
+class MetricsPage;
+class DiagnosticsPage;
+class ProfilesMenu;
+class StagedChangesBar;
 }
 
 class ConfigWindow : public Gtk::Window
@@ -26,20 +47,25 @@ public:
     using KeywordItem = ui::KeywordItem;
     using DeviceConfigItem = ui::DeviceConfigItem;
 
-    class SectionColumns : public Gtk::TreeModel::ColumnRecord {
-    public:
-        SectionColumns() { add(m_col_name); add(m_col_full_path); }
-        Gtk::TreeModelColumn<Glib::ustring> m_col_name;
-        Gtk::TreeModelColumn<Glib::ustring> m_col_full_path;
-    };
-
-    ConfigWindow();
-    ~ConfigWindow() override = default;
+    // With a benchmark, the window clicks through to the settings page by
+    // itself, prints the timings once it has painted, and closes.
+    explicit ConfigWindow(features::StartupBenchmark* startupBenchmark = nullptr);
+    ~ConfigWindow() override;
 
 protected:
     void on_button_refresh();
     void on_hyprland_button_clicked();
     void on_scroll_changed();
+    void on_main_page_changed();
+    void toggle_diagnostics_page();
+    void run_startup_benchmark();
+    void finish_startup_benchmark();
+    std::vector<std::pair<std::string, size_t>> diagnostics_stats() const;
+    void on_search_changed();
+    void on_facets_changed();
+    void apply_option_filters(Gtk::Filter::Change change);
+    void update_option_facets(const std::string& name, const core::OptionValue& value, bool modified);
+    bool option_matches_filter(const Glib::RefPtr<Glib::ObjectBase>& object) const;
 
     Gtk::HeaderBar m_HeaderBar;
     Gtk::Box m_MainVBox;
@@ -47,30 +73,63 @@ protected:
     Gtk::Box m_MenuBox;
     Gtk::Box m_ContentBox;
     Gtk::Box m_HBox;
-    Gtk::TreeView m_TreeView;
     Gtk::ScrolledWindow m_ContentScroll;
     Gtk::Box m_ContentVBox;
     Gtk::Label m_StatusLabel;
     Gtk::Button m_Button_Refresh;
     Gtk::Button m_Button_Hyprland;
+    Gtk::SearchEntry m_SearchEntry;
 
-    SectionColumns m_SectionColumns;
-    Glib::RefPtr<Gtk::TreeStore> m_SectionTreeStore;
+    core::SectionTree m_SectionTree;
+    std::unique_ptr<ui::SectionSidebar> m_Sidebar;
 
     std::map<std::string, Glib::RefPtr<Gio::ListStore<ConfigItem>>> m_SectionStores;
     Glib::RefPtr<Gio::ListStore<KeywordItem>> m_ExecutingStore;
     Glib::RefPtr<Gio::ListStore<KeywordItem>> m_EnvVarStore;
     Glib::RefPtr<Gio::ListStore<DeviceConfigItem>> m_DeviceConfigStore;
-    std::vector<std::unique_ptr<ui::VariablesPanel>> m_VariablesPanels;
+    std::map<std::string, std::unique_ptr<ui::VariablesPanel>> m_VariablesPanels;
     std::unique_ptr<ui::KeywordsPanel> m_ExecutingPanel;
     std::unique_ptr<ui::KeywordsPanel> m_EnvVarsPanel;
     std::unique_ptr<ui::DevicesPanel> m_DevicesPanel;
-    std::vector<std::string> m_AvailableDevices;
-    std::vector<std::string> m_AvailableDeviceOptions;
-    std::unordered_map<std::string, std::string> m_OptionValues;
+    std::vector<InputDevice> m_AvailableDevices;
+    features::DeviceSchema m_DeviceSchema;
+    std::unordered_map<std::string, core::OptionValue> m_OptionValues;
+    // Values sent by slider previews that are not saved yet.
+    std::unordered_map<std::string, core::OptionValue> m_RuntimeValues;
+    features::EditHistory m_History;
     SettingsController m_SettingsController;
-    std::map<std::string, Gtk::TreeModel::iterator> m_SectionIters;
-
+    features::SnapshotPrefetch m_Prefetch;
+    features::OptionRefresh m_OptionRefresh;
+    sigc::connection m_FocusRefresh;
+    sigc::connection m_RefreshPoll;
+    SettingsSnapshot m_Snapshot;
+    std::map<std::string, std::vector<size_t>> m_SectionOptionIndices;
+    std::deque<std::string> m_PendingSections;
+    sigc::connection m_PopulateIdle;
+    sigc::connection m_RealizeIdle;
+
+    core::OptionSearchIndex m_SearchIndex;
+    core::DescriptionIndex m_DescriptionIndex;
+    core::OptionBitset m_SearchMatches;
+    std::string m_SearchQuery;
+    features::OptionFacets m_OptionFacets;
+    std::unique_ptr<ui::FacetBar> m_FacetBar;
+    std::unique_ptr<ui::MetricsPage> m_MetricsPage;
+    std::unique_ptr<ui::DiagnosticsPage> m_DiagnosticsPage;
+    std::unique_ptr<ui::ProfilesMenu> m_ProfilesMenu;
+    features::ProfileStore m_ProfileStore;
+    std::unique_ptr<ui::StagedChangesBar> m_StagedBar;
+    // Edits waiting for Apply in staged mode, by option name.
+    std::map<std::string, core::OptionValue> m_StagedValues;
+    std::string m_PageBeforeDiagnostics;
+    features::StartupBenchmark* m_StartupBenchmark = nullptr;
+    sigc::connection m_StartupPaint;
+    core::OptionBitset m_VisibleOptions;
+    bool m_FilteringOptions = false;
+    Glib::RefPtr<Gtk::CustomFilter> m_OptionFilter;
+    std::unordered_map<std::string, size_t> m_OptionIndices;
+
+    std::map<std::string, std::unique_ptr<ui::SectionSlot>> m_SectionSlots;
     std::map<std::string, Gtk::Widget*> m_SectionWidgets;
     std::vector<std::pair<std::string, Gtk::Widget*>> m_OrderedSections;
     bool m_scrolling_programmatically = false;
@@ -95,17 +154,64 @@ protected:
     void bind_device_value(const Glib::RefPtr<Gtk::ListItem>& list_item);
 
     void load_data();
-    void send_update(const std::string& name, const std::string& value);
-    void send_runtime_update(const std::string& name, const std::string& value);
+    void populate_section(const std::string& sectionPath);
+    bool populate_sections_through(const std::string& sectionPath);
+    bool on_populate_idle();
+    // Returns false when staged mode only recorded the value or Hyprland
+    // rejected it.
+    bool send_update(const std::string& name, const core::OptionValue& value);
+    void send_runtime_update(const std::string& name, const core::OptionValue& value);
+    // Applies and saves the options in one batch, then records every accepted
+    // value, as one undo entry unless record_history is false. Returns false
+    // if any option was rejected.
+    bool apply_option_batch(const OptionAssignments& changes, bool record_history = true);
+    // Stores the changes Hyprland accepted and returns them as history entries.
+    std::vector<features::EditHistory::Change> store_applied_changes(
+        const OptionAssignments& changes, const std::vector<std::string>& failed, bool set_by_user);
+    // Changes that are saved right away (undo, redo, resets, profile
+    // switches) are refused while staging or while staged edits are pending.
+    bool staging_idle(const std::string& action);
+    void undo_last_change();
+    void redo_last_change();
+    // Records a value Hyprland holds now, dropping any staged edit of it.
+    void store_option_value(size_t index, const core::OptionValue& value, bool set_by_user = true);
+    // Puts the options in scope (all when null) back to their defaults with one
+    // config write and one batch.
+    void reset_to_defaults(const core::OptionBitset* scope, const std::string& what);
+    void reset_option(size_t index);
+    void reset_section(const std::string& sectionPath);
+    void reset_all_options();
+    // Re-reads just these options from Hyprland in the background and
+    // updates their rows in place once the batch is back. Options with a
+    // staged edit are left alone.
+    void refresh_options(std::vector<std::string> names);
+    void apply_option_states(const std::vector<OptionState>& states);
+    void refresh_realized_sections();
+    void update_config_item(size_t index, const std::function<void(ConfigItem&)>& update);
+    void set_staging(bool staging);
+    void apply_staged_changes();
+    void discard_staged_changes();
+    void apply_profile(const std::string& name);
+    void save_profile(const std::string& name);
+    void remove_profile(const std::string& name);
     void send_keyword_add(const std::string& type, const std::string& value);
-    void send_device_config_add(const std::string& deviceName, const std::string& option,
+    bool send_device_config_add(const std::string& deviceName, const std::string& option,
                                 const std::string& value);
     void set_status_message(const std::string& text, bool is_error);
-    void create_section_view(const std::string& sectionPath);
+    void create_section_view(const std::string& sectionPath, size_t rowCount);
     void create_executing_view();
     void create_device_configs_view();
     void create_env_vars_view();
-    void on_section_selected();
+    void add_section_slot(const std::string& sectionPath, int placeholderHeight);
+    bool realize_section(const std::string& sectionPath);
+    void evict_section(const std::string& sectionPath);
+    void evict_all_sections();
+    void update_realized_sections();
+    void realize_first_page();
+    void queue_realized_sections_update();
+    void run_after_layout(const std::function<void()>& callback);
+    void on_section_selected(const std::string& sectionPath);
+    void scroll_to_section(const std::string& sectionPath);
 };
 
 #endif
@@ -1,97 +1,416 @@
 #include "config_window.hpp"
 
-#include <algorithm>
-#include <cctype>
-#include <cmath>
-#include <cstdlib>
-#include <optional>
+#include "core/event_ring.hpp"
+#include "core/metrics.hpp"
+#include "features/option_reset.hpp"
+#include "ui/section_slot.hpp"
+#include "ui/staged_changes_bar.hpp"
 
-namespace {
-std::string trim_copy(std::string value) {
-    value.erase(value.begin(),
-                std::find_if(value.begin(), value.end(),
-                             [](unsigned char ch) { return !std::isspace(ch); }));
-    value.erase(std::find_if(value.rbegin(), value.rend(),
-                             [](unsigned char ch) { return !std::isspace(ch); }).base(),
-                value.end());
-    return value;
-}
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+bool ConfigWindow::send_update(const std::string& name, const core::OptionValue& value) {
+    auto known = m_OptionValues.find(name);
+    if (m_StagedBar->staging()) {
+        // Editing back to the applied value leaves nothing to apply.
+        if (known != m_OptionValues.end() && known->second == value) {
+            m_StagedValues.erase(name);
+        } else {
+            m_StagedValues[name] = value;
+        }
+        m_StagedBar->set_pending(m_StagedValues.size());
+        return false;
+    }
 
-std::string lower_copy(std::string value) {
-    std::transform(value.begin(), value.end(), value.begin(),
-                   [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
-    return value;
+    // Changes staged before leaving staged mode are superseded by this one.
+    if (m_StagedValues.erase(name) > 0) {
+        m_StagedBar->set_pending(m_StagedValues.size());
+    }
+
+    m_RuntimeValues.erase(name);
+    if (known != m_OptionValues.end() && known->second == value) {
+        core::metrics::add(core::metrics::Counter::CoalescedUpdates);
+        core::event_ring().push(core::EventKind::CoalescedUpdate, name, core::EventRing::Clock::now(), true);
+        // Closes a drag that ended on the value it started from.
+        m_History.record(name, value.str(), value.str());
+        return true;
+    }
+
+    const auto start = core::EventRing::Clock::now();
+    bool ok = m_SettingsController.apply_persistent_option(name, value.str());
+    core::event_ring().push(core::EventKind::PersistentUpdate, name, start, ok);
+    if (ok) {
+        m_History.record(name, known != m_OptionValues.end() ? known->second.str() : "", value.str());
+        m_OptionValues[name] = value;
+        // The device editor and later refreshes compare against the snapshot.
+        // The row already shows the value, so it is not rebound here.
+        if (auto index = m_OptionIndices.find(name); index != m_OptionIndices.end()) {
+            ConfigOptionData& option = m_Snapshot.options[index->second];
+            option.value = value.str();
+            option.set_by_user = true;
+        }
+        update_option_facets(name, value, true);
+        set_status_message("Applied " + name + " = " + value.str(), false);
+    } else {
+        set_status_message("Failed to apply " + name, true);
+    }
+    return ok;
 }
 
-std::optional<double> parse_number_full(const std::string& value) {
-    const std::string trimmed = trim_copy(value);
-    if (trimmed.empty()) {
-        return std::nullopt;
+void ConfigWindow::send_runtime_update(const std::string& name, const core::OptionValue& value) {
+    // Staged edits reach Hyprland only on Apply, so Discard has nothing to undo.
+    if (m_StagedBar->staging()) {
+        return;
     }
 
-    char* end = nullptr;
-    const double parsed = std::strtod(trimmed.c_str(), &end);
-    if (end == nullptr || *end != '\0') {
-        return std::nullopt;
+    // Previews are compared with the last preview, not the saved value, so
+    // the save at the end of a drag is not mistaken for a repeat.
+    const core::OptionValue* previous = nullptr;
+    auto preview = m_RuntimeValues.find(name);
+    if (preview != m_RuntimeValues.end()) {
+        previous = &preview->second;
+    } else if (auto saved = m_OptionValues.find(name); saved != m_OptionValues.end()) {
+        previous = &saved->second;
+    }
+    if (previous && *previous == value) {
+        core::metrics::add(core::metrics::Counter::CoalescedUpdates);
+        core::event_ring().push(core::EventKind::CoalescedUpdate, name, core::EventRing::Clock::now(), true);
+        return;
+    }
+
+    const auto start = core::EventRing::Clock::now();
+    bool ok = m_SettingsController.apply_runtime_option(name, value.str());
+    core::event_ring().push(core::EventKind::RuntimeUpdate, name, start, ok);
+    if (ok) {
+        // Every step of the drag merges into one undo entry.
+        m_History.record(name, previous ? previous->str() : "", value.str(), true);
+        m_RuntimeValues[name] = value;
+    } else {
+        set_status_message("Failed runtime update for " + name, true);
     }
-    return parsed;
 }
 
-bool equivalent_option_values(const std::string& lhs, const std::string& rhs) {
-    if (lhs == rhs) {
+bool ConfigWindow::apply_option_batch(const OptionAssignments& changes, bool record_history) {
+    if (changes.empty()) {
         return true;
     }
 
-    const std::string l = lower_copy(trim_copy(lhs));
-    const std::string r = lower_copy(trim_copy(rhs));
-    if (l == r) {
-        return true;
+    std::vector<std::string> failed;
+    const bool ok = m_SettingsController.apply_persistent_options(changes, &failed);
+    auto applied = store_applied_changes(changes, failed, true);
+    if (record_history) {
+        m_History.record_batch(std::move(applied));
     }
+    return ok;
+}
 
-    const bool l_true = (l == "true" || l == "1");
-    const bool l_false = (l == "false" || l == "0");
-    const bool r_true = (r == "true" || r == "1");
-    const bool r_false = (r == "false" || r == "0");
-    if ((l_true || l_false) && (r_true || r_false)) {
-        return (l_true && r_true) || (l_false && r_false);
+std::vector<features::EditHistory::Change> ConfigWindow::store_applied_changes(
+    const OptionAssignments& changes, const std::vector<std::string>& failed, bool set_by_user) {
+    const std::unordered_set<std::string> rejected(failed.begin(), failed.end());
+    std::vector<features::EditHistory::Change> applied;
+    applied.reserve(changes.size());
+    for (const auto& change : changes) {
+        auto index = m_OptionIndices.find(change.first);
+        if (index == m_OptionIndices.end() || rejected.count(change.first) > 0) {
+            continue;
+        }
+        const int type = m_Snapshot.options[index->second].value_type;
+        const core::OptionValue value = core::OptionValue::decode(type, change.second);
+        auto known = m_OptionValues.find(change.first);
+        applied.push_back({change.first, known != m_OptionValues.end() ? known->second.str() : "", value.str()});
+        store_option_value(index->second, value, set_by_user);
     }
+    return applied;
+}
 
-    const auto l_num = parse_number_full(l);
-    const auto r_num = parse_number_full(r);
-    if (l_num.has_value() && r_num.has_value()) {
-        return std::fabs(*l_num - *r_num) < 1e-9;
+bool ConfigWindow::staging_idle(const std::string& action) {
+    // Undo, redo, resets and profile switches are applied and saved at once,
+    // which would bypass staging and silently replace staged edits of the
+    // same options.
+    if (m_StagedBar->staging() || !m_StagedValues.empty()) {
+        set_status_message("Apply or discard staged changes before " + action, false);
+        return false;
     }
+    return true;
+}
 
-    return false;
+void ConfigWindow::undo_last_change() {
+    if (!staging_idle("undo")) {
+        return;
+    }
+    const OptionAssignments changes = m_History.undo();
+    if (changes.empty()) {
+        set_status_message("Nothing to undo", false);
+        return;
+    }
+    if (apply_option_batch(changes, false)) {
+        set_status_message("Undid " + std::to_string(changes.size()) + " changes", false);
+    } else {
+        set_status_message("Some changes could not be undone", true);
+    }
 }
+
+void ConfigWindow::redo_last_change() {
+    if (!staging_idle("redo")) {
+        return;
+    }
+    const OptionAssignments changes = m_History.redo();
+    if (changes.empty()) {
+        set_status_message("Nothing to redo", false);
+        return;
+    }
+    if (apply_option_batch(changes, false)) {
+        set_status_message("Redid " + std::to_string(changes.size()) + " changes", false);
+    } else {
+        set_status_message("Some changes could not be redone", true);
+    }
 }
 
-void ConfigWindow::send_update(const std::string& name, const std::string& value) {
-    auto known = m_OptionValues.find(name);
-    if (known != m_OptionValues.end() && equivalent_option_values(known->second, value)) {
+void ConfigWindow::store_option_value(size_t index, const core::OptionValue& value, bool set_by_user) {
+    ConfigOptionData& option = m_Snapshot.options[index];
+    option.value = value.str();
+    option.set_by_user = set_by_user;
+    m_OptionValues[option.name] = value;
+    m_RuntimeValues.erase(option.name);
+    m_OptionFacets.set_modified(index, set_by_user);
+    m_OptionFacets.set_value(index, value);
+
+    // A stored value supersedes anything staged for the option.
+    if (m_StagedValues.erase(option.name) > 0) {
+        m_StagedBar->set_pending(m_StagedValues.size());
+    }
+    update_config_item(index, [&value, set_by_user](ConfigItem& item) {
+        item.m_value = value;
+        item.m_lastAppliedValue = value;
+        item.m_setByUser = set_by_user;
+    });
+}
+
+void ConfigWindow::reset_to_defaults(const core::OptionBitset* scope, const std::string& what) {
+    if (!staging_idle("resetting")) {
+        return;
+    }
+    const OptionAssignments defaults = features::reset_changes(m_Snapshot, m_OptionFacets, scope);
+    if (defaults.empty()) {
+        set_status_message(what + " already at defaults", false);
         return;
     }
 
-    bool ok = m_SettingsController.apply_persistent_option(name, value);
+    std::vector<std::string> failed;
+    const bool ok = m_SettingsController.reset_options(defaults, &failed);
+    m_History.record_batch(store_applied_changes(defaults, failed, false));
+
     if (ok) {
-        m_OptionValues[name] = value;
-        set_status_message("Applied " + name + " = " + value, false);
+        set_status_message("Reset " + std::to_string(defaults.size()) + " options in " + what, false);
     } else {
-        set_status_message("Failed to apply " + name, true);
+        set_status_message("Failed to reset " + std::to_string(failed.size()) + " options in " + what, true);
     }
 }
 
-void ConfigWindow::send_runtime_update(const std::string& name, const std::string& value) {
-    auto known = m_OptionValues.find(name);
-    if (known != m_OptionValues.end() && equivalent_option_values(known->second, value)) {
+void ConfigWindow::reset_option(size_t index) {
+    if (index >= m_Snapshot.options.size()) {
+        return;
+    }
+    core::OptionBitset scope(m_Snapshot.options.size());
+    scope.set(index);
+    reset_to_defaults(&scope, m_Snapshot.options[index].name);
+}
+
+void ConfigWindow::reset_section(const std::string& sectionPath) {
+    const core::OptionBitset scope = features::section_options(m_Snapshot, sectionPath);
+    reset_to_defaults(&scope, sectionPath);
+}
+
+void ConfigWindow::reset_all_options() {
+    if (m_Snapshot.options.empty()) {
+        load_data();
+    }
+    reset_to_defaults(nullptr, "all sections");
+}
+
+void ConfigWindow::refresh_options(std::vector<std::string> names) {
+    if (names.empty() || m_Snapshot.options.empty()) {
+        return;
+    }
+    m_OptionRefresh.start(std::move(names));
+    if (m_RefreshPoll.connected()) {
         return;
     }
+    m_RefreshPoll = Glib::signal_timeout().connect(
+        [this]() {
+            if (auto states = m_OptionRefresh.poll()) {
+                apply_option_states(*states);
+            }
+            return m_OptionRefresh.running();
+        },
+        50);
+}
+
+void ConfigWindow::apply_option_states(const std::vector<OptionState>& states) {
+    for (const auto& state : states) {
+        auto index = m_OptionIndices.find(state.name);
+        if (index == m_OptionIndices.end() || m_StagedValues.count(state.name) > 0) {
+            continue;
+        }
+        const ConfigOptionData& option = m_Snapshot.options[index->second];
+        const core::OptionValue value = core::OptionValue::decode(option.value_type, state.value);
+        auto known = m_OptionValues.find(state.name);
+        if (known != m_OptionValues.end() && known->second == value && option.set_by_user == state.set_by_user) {
+            continue;
+        }
+        store_option_value(index->second, value, state.set_by_user);
+    }
+}
 
-    bool ok = m_SettingsController.apply_runtime_option(name, value);
+void ConfigWindow::refresh_realized_sections() {
+    std::vector<std::string> names;
+    for (const auto& slot : m_SectionSlots) {
+        if (!slot.second->is_realized()) {
+            continue;
+        }
+        auto store = m_SectionStores.find(slot.first);
+        if (store == m_SectionStores.end()) {
+            continue;
+        }
+        const guint count = store->second->get_n_items();
+        for (guint position = 0; position < count; ++position) {
+            names.push_back(store->second->get_item(position)->m_name);
+        }
+    }
+    refresh_options(std::move(names));
+}
+
+void ConfigWindow::update_config_item(size_t index, const std::function<void(ConfigItem&)>& update) {
+    // Sections not populated yet build their rows from m_Snapshot later.
+    auto store = m_SectionStores.find(m_Snapshot.options[index].section_path);
+    if (store == m_SectionStores.end()) {
+        return;
+    }
+    const guint count = store->second->get_n_items();
+    for (guint position = 0; position < count; ++position) {
+        auto item = store->second->get_item(position);
+        if (item->m_optionIndex != index) {
+            continue;
+        }
+        update(*item);
+        // Replacing the item with itself makes the view rebind the row.
+        store->second->splice(position, 1, {item});
+        return;
+    }
+}
+
+void ConfigWindow::set_staging(bool staging) {
+    m_StagedBar->set_pending(m_StagedValues.size());
+    if (!staging && !m_StagedValues.empty()) {
+        set_status_message(std::to_string(m_StagedValues.size()) + " staged changes still pending", false);
+    }
+}
+
+void ConfigWindow::apply_staged_changes() {
+    if (m_StagedValues.empty()) {
+        return;
+    }
+
+    OptionAssignments changes;
+    changes.reserve(m_StagedValues.size());
+    for (const auto& staged : m_StagedValues) {
+        changes.emplace_back(staged.first, staged.second.str());
+    }
+
+    // Accepted values leave m_StagedValues through store_option_value, which
+    // updates the badge; the rejected ones stay staged so they can be fixed
+    // or discarded.
+    const bool ok = apply_option_batch(changes);
     if (ok) {
-        m_OptionValues[name] = value;
+        set_status_message("Applied " + std::to_string(changes.size()) + " changes", false);
     } else {
-        set_status_message("Failed runtime update for " + name, true);
+        set_status_message(std::to_string(m_StagedValues.size()) + " of " + std::to_string(changes.size()) +
+                               " changes could not be applied",
+                           true);
+    }
+}
+
+void ConfigWindow::discard_staged_changes() {
+    const size_t count = m_StagedValues.size();
+    for (const auto& staged : m_StagedValues) {
+        auto index = m_OptionIndices.find(staged.first);
+        if (index == m_OptionIndices.end()) {
+            continue;
+        }
+        update_config_item(index->second, [](ConfigItem& item) { item.m_value = item.m_lastAppliedValue; });
+    }
+    m_StagedValues.clear();
+    m_StagedBar->set_pending(0);
+    set_status_message("Discarded " + std::to_string(count) + " changes", false);
+}
+
+void ConfigWindow::apply_profile(const std::string& name) {
+    if (!staging_idle("switching profiles")) {
+        return;
+    }
+    const auto profile = m_ProfileStore.load(name);
+    if (!profile) {
+        set_status_message("Could not read profile " + name, true);
+        return;
+    }
+    if (m_Snapshot.options.empty()) {
+        load_data();
+    }
+
+    const features::ProfileChanges changes =
+        features::profile_changes(*profile, m_Snapshot, m_OptionIndices, m_OptionValues, m_OptionFacets);
+
+    // Profile values are written to the config; options going back to their
+    // default lose their assignment instead, so switching back and forth
+    // does not grow the config or mark defaults as set. Both go out in one
+    // config write and one batch, and one undo step covers them.
+    std::vector<std::string> failed;
+    const bool ok = m_SettingsController.apply_changes(changes.values, changes.defaults, &failed);
+    std::vector<features::EditHistory::Change> applied = store_applied_changes(changes.values, failed, true);
+    auto reset = store_applied_changes(changes.defaults, failed, false);
+    applied.insert(applied.end(), reset.begin(), reset.end());
+    m_History.record_batch(std::move(applied));
+
+    // Read back what Hyprland made of the new values, e.g. clamped numbers.
+    std::vector<std::string> names;
+    names.reserve(changes.size());
+    for (const auto* list : {&changes.values, &changes.defaults}) {
+        for (const auto& change : *list) {
+            names.push_back(change.first);
+        }
+    }
+    refresh_options(std::move(names));
+
+    if (ok) {
+        set_status_message("Switched to " + name + " (" + std::to_string(changes.size()) + " changes)", false);
+    } else {
+        set_status_message("Some options in " + name + " could not be applied", true);
+    }
+}
+
+void ConfigWindow::save_profile(const std::string& name) {
+    if (!features::ProfileStore::valid_name(name)) {
+        set_status_message("Profile names cannot contain '/' or start with '.'", true);
+        return;
+    }
+    if (m_Snapshot.options.empty()) {
+        load_data();
+    }
+
+    const features::Profile profile = features::capture_profile(name, m_Snapshot, m_OptionValues, m_OptionFacets);
+    if (m_ProfileStore.save(profile)) {
+        set_status_message("Saved profile " + name, false);
+    } else {
+        set_status_message("Failed to save profile " + name, true);
+    }
+}
+
+void ConfigWindow::remove_profile(const std::string& name) {
+    if (m_ProfileStore.remove(name)) {
+        set_status_message("Deleted profile " + name, false);
+    } else {
+        set_status_message("Failed to delete profile " + name, true);
     }
 }
 
@@ -104,7 +423,7 @@ void ConfigWindow::send_keyword_add(const std::string& type, const std::string&
     }
 }
 
-void ConfigWindow::send_device_config_add(const std::string& deviceName, const std::string& option,
+bool ConfigWindow::send_device_config_add(const std::string& deviceName, const std::string& option,
                                           const std::string& value) {
     bool ok = m_SettingsController.add_device_config(deviceName, option, value);
     if (ok) {
@@ -112,4 +431,5 @@ void ConfigWindow::send_device_config_add(const std::string& deviceName, const s
     } else {
         set_status_message("Failed device config " + deviceName + ":" + option, true);
     }
+    return ok;
 }
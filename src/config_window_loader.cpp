@@ -1,22 +1,55 @@
 #include "config_window.hpp"
 
+#include "core/event_ring.hpp"
+#include "core/trace.hpp"
 #include "ui/devices_panel.hpp"
+#include "ui/facet_bar.hpp"
 #include "ui/keywords_panel.hpp"
+#include "ui/section_sidebar.hpp"
+#include "ui/section_slot.hpp"
 #include "ui/variables_panel.hpp"
 
-#include <set>
-#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+
+namespace {
+// Rows added synchronously so the first page paints fully populated.
+constexpr size_t kFirstPageRows = 40;
+// Time an idle pass may spend filling the remaining sections.
+constexpr auto kPopulateIdleBudget = std::chrono::milliseconds(4);
+}
 
 void ConfigWindow::load_data() {
-    m_TreeView.get_selection()->unselect_all();
+    HYPRLAND_TRACE_SPAN("window.load_data");
+    const auto loadStart = core::EventRing::Clock::now();
+#ifdef HYPRLAND_SETTINGS_TRACING
+    if (core::trace::enabled()) {
+        // Covers everything up to the frame that shows the new rows.
+        const uint64_t start = core::trace::now_ns();
+        add_tick_callback([start](const Glib::RefPtr<Gdk::FrameClock>&) {
+            core::trace::record("window.load_to_first_frame", start, core::trace::now_ns());
+            return false;
+        });
+    }
+#endif
+    m_PopulateIdle.disconnect();
+    m_PendingSections.clear();
+    m_SectionOptionIndices.clear();
+    m_Sidebar->set_tree(nullptr);
     m_OptionValues.clear();
+    m_RuntimeValues.clear();
+    // Staged edits belong to rows that are about to be rebuilt.
+    m_StagedValues.clear();
+    m_StagedBar->set_pending(0);
 
     for (auto& kv : m_SectionStores) {
         kv.second->remove_all();
     }
-    m_SectionTreeStore->clear();
+    m_SectionTree.clear();
     m_SectionStores.clear();
-    m_SectionIters.clear();
+    m_SectionSlots.clear();
     m_SectionWidgets.clear();
     m_OrderedSections.clear();
     m_VariablesPanels.clear();
@@ -28,48 +61,27 @@ void ConfigWindow::load_data() {
         m_ContentVBox.remove(*child);
     }
 
-    SettingsSnapshot snapshot = m_SettingsController.load_snapshot();
+    features::PreparedSnapshot prepared = m_Prefetch.take();
+    if (m_StartupBenchmark) {
+        m_StartupBenchmark->mark("snapshot_ready");
+    }
+    m_Snapshot = std::move(prepared.snapshot);
+    m_SectionTree = std::move(prepared.sections);
+    m_SectionOptionIndices = std::move(prepared.section_option_indices);
+    m_DeviceSchema = std::move(prepared.device_schema);
+    m_SearchIndex = std::move(prepared.search_index);
+    m_DescriptionIndex = std::move(prepared.description_index);
+    m_OptionIndices = std::move(prepared.option_indices);
+
+    const SettingsSnapshot& snapshot = m_Snapshot;
     m_AvailableDevices = snapshot.available_devices;
-    m_AvailableDeviceOptions.clear();
-
-    std::set<std::string> uniqueDeviceOptions;
     for (const auto& option : snapshot.options) {
-        if (option.name.empty()) {
-            continue;
-        }
-
-        size_t pos = option.name.rfind(':');
-        std::string shortName = (pos == std::string::npos) ? option.name : option.name.substr(pos + 1);
-        if (!shortName.empty()) {
-            uniqueDeviceOptions.insert(shortName);
-        }
+        m_OptionValues[option.name] = core::OptionValue::decode(option.value_type, option.value);
     }
-    m_AvailableDeviceOptions.assign(uniqueDeviceOptions.begin(), uniqueDeviceOptions.end());
-
-    auto variablesIter = m_SectionTreeStore->append();
-    (*variablesIter)[m_SectionColumns.m_col_name] = "Variables";
-    (*variablesIter)[m_SectionColumns.m_col_full_path] = "__variables__";
-    m_SectionIters["__variables__"] = variablesIter;
-
-    auto keywordsIter = m_SectionTreeStore->append();
-    (*keywordsIter)[m_SectionColumns.m_col_name] = "Keywords";
-    (*keywordsIter)[m_SectionColumns.m_col_full_path] = "__keywords_parent__";
-    m_SectionIters["__keywords_parent__"] = keywordsIter;
-
-    auto executingIter = m_SectionTreeStore->append(keywordsIter->children());
-    (*executingIter)[m_SectionColumns.m_col_name] = "Executing";
-    (*executingIter)[m_SectionColumns.m_col_full_path] = "__executing__";
-    m_SectionIters["__executing__"] = executingIter;
-
-    auto deviceConfigsIter = m_SectionTreeStore->append(keywordsIter->children());
-    (*deviceConfigsIter)[m_SectionColumns.m_col_name] = "Per-device Input Configs";
-    (*deviceConfigsIter)[m_SectionColumns.m_col_full_path] = "__device_configs__";
-    m_SectionIters["__device_configs__"] = deviceConfigsIter;
-
-    auto envVarsIter = m_SectionTreeStore->append(keywordsIter->children());
-    (*envVarsIter)[m_SectionColumns.m_col_name] = "Environment Variables";
-    (*envVarsIter)[m_SectionColumns.m_col_full_path] = "__env_vars__";
-    m_SectionIters["__env_vars__"] = envVarsIter;
+    // Rows take their reset button from the facets' defaults, so these must
+    // match the new snapshot before the first section is populated.
+    m_OptionFacets.rebuild(snapshot);
+    m_FacetBar->set_sections(m_OptionFacets.sections());
 
     auto varsHeader = Gtk::make_managed<Gtk::Label>("Variables");
     varsHeader->add_css_class("section-title");
@@ -79,44 +91,19 @@ void ConfigWindow::load_data() {
     varsHeader->add_css_class("main-category-title");
     m_ContentVBox.append(*varsHeader);
 
-    for (const auto& sectionPath : snapshot.sections) {
-        if (sectionPath.empty()) continue;
-
-        std::stringstream ss(sectionPath);
-        std::string part;
-        std::string currentPath;
-        Gtk::TreeModel::iterator parentIter = variablesIter;
-
-        while (std::getline(ss, part, ':')) {
-            if (part.empty()) continue;
-            if (!currentPath.empty()) currentPath += ":";
-            currentPath += part;
-
-            if (m_SectionIters.find(currentPath) == m_SectionIters.end()) {
-                auto newIter = m_SectionTreeStore->append(parentIter->children());
-                (*newIter)[m_SectionColumns.m_col_name] = part;
-                (*newIter)[m_SectionColumns.m_col_full_path] = currentPath;
-                m_SectionIters[currentPath] = newIter;
-            }
-            parentIter = m_SectionIters[currentPath];
-        }
-    }
-
-    if (snapshot.has_root_options && m_SectionIters.find("") == m_SectionIters.end()) {
-        auto iter = m_SectionTreeStore->append(variablesIter->children());
-        (*iter)[m_SectionColumns.m_col_name] = "(root)";
-        (*iter)[m_SectionColumns.m_col_full_path] = "";
-        m_SectionIters[""] = iter;
-    }
+    const auto rowCount = [this](const std::string& sectionPath) -> size_t {
+        auto options = m_SectionOptionIndices.find(sectionPath);
+        return options == m_SectionOptionIndices.end() ? 0 : options->second.size();
+    };
 
     if (snapshot.has_root_options && m_SectionWidgets.find("") == m_SectionWidgets.end()) {
-        create_section_view("");
+        create_section_view("", rowCount(""));
     }
 
     for (const auto& sectionPath : snapshot.sections) {
         if (sectionPath.empty()) continue;
         if (m_SectionWidgets.find(sectionPath) == m_SectionWidgets.end()) {
-            create_section_view(sectionPath);
+            create_section_view(sectionPath, rowCount(sectionPath));
         }
     }
 
@@ -135,22 +122,92 @@ void ConfigWindow::load_data() {
     m_EnvVarStore->remove_all();
     m_DeviceConfigStore->remove_all();
 
-    m_TreeView.expand_row(Gtk::TreePath(keywordsIter), false);
+    // Fill the sections at the top right away and leave the rest to idle time.
+    size_t firstPageRows = 0;
+    for (const auto& section : m_OrderedSections) {
+        auto options = m_SectionOptionIndices.find(section.first);
+        if (options == m_SectionOptionIndices.end()) {
+            continue;
+        }
+
+        if (firstPageRows < kFirstPageRows) {
+            firstPageRows += options->second.size();
+            populate_section(section.first);
+        } else {
+            m_PendingSections.push_back(section.first);
+        }
+    }
+    if (!m_PendingSections.empty()) {
+        m_PopulateIdle = Glib::signal_idle().connect(sigc::mem_fun(*this, &ConfigWindow::on_populate_idle));
+    }
 
-    for (const auto& option : snapshot.options) {
-        m_OptionValues[option.name] = option.value;
-        auto it = m_SectionStores.find(option.section_path);
-        if (it != m_SectionStores.end()) {
-            it->second->append(ConfigItem::create(option.name, option.value, option.description,
-                                                  option.set_by_user, option.value_type,
-                                                  option.choice_values_csv,
-                                                  option.has_range, option.range_min,
-                                                  option.range_max,
-                                                  option.has_vector_range,
-                                                  option.vector_min_x, option.vector_min_y,
-                                                  option.vector_max_x, option.vector_max_y));
+    if (m_MainStack.get_visible_child_name() == "content") {
+        realize_first_page();
+    }
+
+    m_Sidebar->set_tree(&m_SectionTree);
+    m_Sidebar->expand("__keywords_parent__");
+    m_Sidebar->expand("__variables__");
+
+    m_SearchQuery.clear();
+    if (!m_SearchEntry.get_text().empty()) {
+        on_search_changed();
+    } else {
+        apply_option_filters(Gtk::Filter::Change::DIFFERENT);
+    }
+
+    core::event_ring().push(core::EventKind::LoadData, std::to_string(snapshot.options.size()) + " options",
+                            loadStart, !snapshot.options.empty());
+}
+
+void ConfigWindow::populate_section(const std::string& sectionPath) {
+    HYPRLAND_TRACE_SPAN_DETAIL("window.populate_section", sectionPath);
+    auto options = m_SectionOptionIndices.find(sectionPath);
+    if (options == m_SectionOptionIndices.end()) {
+        return;
+    }
+
+    auto store = m_SectionStores.find(sectionPath);
+    if (store != m_SectionStores.end()) {
+        std::vector<Glib::RefPtr<ConfigItem>> items;
+        items.reserve(options->second.size());
+        for (size_t index : options->second) {
+            auto item = ui::make_config_item(m_Snapshot.options[index]);
+            item->m_optionIndex = index;
+            item->m_hasDefault = m_OptionFacets.default_value(index).has_value();
+            items.push_back(item);
         }
+        store->second->splice(store->second->get_n_items(), 0, items);
+    }
+    m_SectionOptionIndices.erase(options);
+}
+
+bool ConfigWindow::populate_sections_through(const std::string& sectionPath) {
+    auto last = std::find(m_PendingSections.begin(), m_PendingSections.end(), sectionPath);
+    if (last == m_PendingSections.end()) {
+        return false;
     }
 
-    m_TreeView.expand_row(Gtk::TreePath(variablesIter), false);
+    ++last;
+    for (auto it = m_PendingSections.begin(); it != last; ++it) {
+        populate_section(*it);
+    }
+    m_PendingSections.erase(m_PendingSections.begin(), last);
+    if (m_PendingSections.empty()) {
+        m_PopulateIdle.disconnect();
+    }
+    return true;
+}
+
+bool ConfigWindow::on_populate_idle() {
+    HYPRLAND_TRACE_SPAN("window.populate_idle");
+    const auto start = std::chrono::steady_clock::now();
+    while (!m_PendingSections.empty()) {
+        populate_section(m_PendingSections.front());
+        m_PendingSections.pop_front();
+        if (std::chrono::steady_clock::now() - start >= kPopulateIdleBudget) {
+            break;
+        }
+    }
+    return !m_PendingSections.empty();
 }
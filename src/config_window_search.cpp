@@ -0,0 +1,102 @@
+#include "config_window.hpp"
+
+#include "ui/facet_bar.hpp"
+#include "ui/section_sidebar.hpp"
+
+#include <unordered_set>
+
+bool ConfigWindow::option_matches_filter(const Glib::RefPtr<Glib::ObjectBase>& object) const {
+    if (!m_FilteringOptions) {
+        return true;
+    }
+
+    auto item = std::dynamic_pointer_cast<ConfigItem>(object);
+    return item && m_VisibleOptions.test(item->m_optionIndex);
+}
+
+void ConfigWindow::on_search_changed() {
+    const bool wasSearching = !m_SearchQuery.empty();
+    const core::OptionBitset previousMatches = std::move(m_SearchMatches);
+    // A query of only spaces matches no name, so it counts as no search
+    // rather than hiding every row.
+    const std::string text = m_SearchEntry.get_text();
+    m_SearchQuery = core::OptionSearchIndex::normalize_query(text).empty() ? std::string() : text;
+
+    // Name matches rank first; options whose description mentions the query
+    // are shown too, behind them.
+    const auto& nameMatches = m_SearchIndex.search(m_SearchQuery);
+    const auto descriptionMatches = m_DescriptionIndex.search(m_SearchQuery);
+
+    m_SearchMatches = core::OptionBitset(m_Snapshot.options.size());
+    for (const auto* matches : {&nameMatches, &descriptionMatches}) {
+        for (const auto& match : *matches) {
+            m_SearchMatches.set(match.option);
+        }
+    }
+
+    // Tell the filter models which direction the matches moved so they only
+    // re-check the rows that can actually change. This follows the match
+    // sets, not the query text: extending a query can add description matches
+    // once a word is long enough to be indexed.
+    const bool searching = !m_SearchQuery.empty();
+    auto change = Gtk::Filter::Change::DIFFERENT;
+    if (!wasSearching || (searching && m_SearchMatches.is_subset_of(previousMatches))) {
+        change = Gtk::Filter::Change::MORE_STRICT;
+    } else if (!searching || previousMatches.is_subset_of(m_SearchMatches)) {
+        change = Gtk::Filter::Change::LESS_STRICT;
+    }
+    apply_option_filters(change);
+
+    const auto& best = nameMatches.empty() ? descriptionMatches : nameMatches;
+    if (!best.empty() && best.front().option < m_Snapshot.options.size()) {
+        // Bring the section holding the best-ranked match into view.
+        const std::string& bestSection = m_Snapshot.options[best.front().option].section_path;
+        m_selecting_programmatically = true;
+        m_Sidebar->select(bestSection);
+        m_selecting_programmatically = false;
+        on_section_selected(bestSection);
+    }
+}
+
+void ConfigWindow::on_facets_changed() {
+    apply_option_filters(Gtk::Filter::Change::DIFFERENT);
+}
+
+void ConfigWindow::apply_option_filters(Gtk::Filter::Change change) {
+    features::FacetSelection selection;
+    selection.modified_only = m_FacetBar->modified_only();
+    selection.non_default_only = m_FacetBar->non_default_only();
+    selection.value_type = m_FacetBar->value_type();
+    selection.section = m_FacetBar->section();
+
+    const bool searching = !m_SearchQuery.empty();
+    const bool faceted = selection.modified_only || selection.non_default_only ||
+                         selection.value_type >= 0 || !selection.section.empty();
+    m_FilteringOptions = searching || faceted;
+    m_VisibleOptions = m_OptionFacets.combine(selection, searching ? &m_SearchMatches : nullptr);
+    m_OptionFilter->changed(change);
+
+    std::unordered_set<std::string> visibleSections;
+    for (size_t i = 0; i < m_Snapshot.options.size(); ++i) {
+        if (m_VisibleOptions.test(i)) {
+            visibleSections.insert(m_Snapshot.options[i].section_path);
+        }
+    }
+
+    for (const auto& section : m_OrderedSections) {
+        const bool variables = m_SectionStores.find(section.first) != m_SectionStores.end();
+        const bool visible = !m_FilteringOptions ||
+                             (variables && visibleSections.count(section.first) > 0);
+        section.second->set_visible(visible);
+    }
+}
+
+void ConfigWindow::update_option_facets(const std::string& name, const core::OptionValue& value, bool modified) {
+    auto index = m_OptionIndices.find(name);
+    if (index == m_OptionIndices.end()) {
+        return;
+    }
+
+    m_OptionFacets.set_modified(index->second, modified);
+    m_OptionFacets.set_value(index->second, value);
+}
@@ -1,104 +1,207 @@
 #include "config_window.hpp"
 
+#include "core/trace.hpp"
 #include "ui/devices_panel.hpp"
 #include "ui/keywords_panel.hpp"
 #include "ui/option_name_cell.hpp"
 #include "ui/option_value_editor.hpp"
+#include "ui/section_slot.hpp"
 #include "ui/variables_panel.hpp"
 
-void ConfigWindow::create_section_view(const std::string& sectionPath) {
-    auto listStore = Gio::ListStore<ConfigItem>::create();
-    m_SectionStores[sectionPath] = listStore;
-
-    auto panel = std::make_unique<ui::VariablesPanel>(
-        sectionPath,
-        listStore,
-        sigc::mem_fun(*this, &ConfigWindow::setup_column_read),
-        sigc::mem_fun(*this, &ConfigWindow::setup_column_edit),
-        sigc::mem_fun(*this, &ConfigWindow::bind_name),
-        sigc::mem_fun(*this, &ConfigWindow::bind_value));
+namespace {
+// Placeholder heights used until a section has been built once.
+constexpr int kSectionHeaderHeight = 70;
+constexpr int kOptionRowHeight = 50;
+constexpr int kKeywordPanelHeight = 220;
+}
 
-    Gtk::Box* sectionBox = panel->widget();
-    m_ContentVBox.append(*sectionBox);
-    m_SectionWidgets[sectionPath] = sectionBox;
-    m_OrderedSections.push_back({sectionPath, sectionBox});
-    m_VariablesPanels.push_back(std::move(panel));
+void ConfigWindow::create_section_view(const std::string& sectionPath, size_t rowCount) {
+    m_SectionStores[sectionPath] = Gio::ListStore<ConfigItem>::create();
+    add_section_slot(sectionPath, kSectionHeaderHeight + static_cast<int>(rowCount) * kOptionRowHeight);
 }
 
 void ConfigWindow::create_executing_view() {
-    const std::string sectionPath = "__executing__";
-    m_ExecutingPanel = std::make_unique<ui::KeywordsPanel>(
-        ui::KeywordsPanel::Kind::Executing,
-        m_ExecutingStore,
-        [this](const std::string& type, const std::string& value) { send_keyword_add(type, value); },
-        sigc::mem_fun(*this, &ConfigWindow::setup_keyword_type),
-        sigc::mem_fun(*this, &ConfigWindow::setup_keyword_value),
-        sigc::mem_fun(*this, &ConfigWindow::bind_keyword_type),
-        sigc::mem_fun(*this, &ConfigWindow::bind_keyword_value));
-
-    Gtk::Box* mainBox = m_ExecutingPanel->widget();
-    m_ContentVBox.append(*mainBox);
-    m_SectionWidgets[sectionPath] = mainBox;
-    m_OrderedSections.push_back({sectionPath, mainBox});
+    add_section_slot("__executing__", kKeywordPanelHeight);
 }
 
 void ConfigWindow::create_env_vars_view() {
-    const std::string sectionPath = "__env_vars__";
-    m_EnvVarsPanel = std::make_unique<ui::KeywordsPanel>(
-        ui::KeywordsPanel::Kind::EnvironmentVariables,
-        m_EnvVarStore,
-        [this](const std::string& type, const std::string& value) { send_keyword_add(type, value); },
-        sigc::mem_fun(*this, &ConfigWindow::setup_keyword_type),
-        sigc::mem_fun(*this, &ConfigWindow::setup_keyword_value),
-        sigc::mem_fun(*this, &ConfigWindow::bind_keyword_type),
-        sigc::mem_fun(*this, &ConfigWindow::bind_keyword_value));
-
-    Gtk::Box* mainBox = m_EnvVarsPanel->widget();
-    m_ContentVBox.append(*mainBox);
-    m_SectionWidgets[sectionPath] = mainBox;
-    m_OrderedSections.push_back({sectionPath, mainBox});
+    add_section_slot("__env_vars__", kKeywordPanelHeight);
 }
 
 void ConfigWindow::create_device_configs_view() {
-    const std::string sectionPath = "__device_configs__";
-    m_DevicesPanel = std::make_unique<ui::DevicesPanel>(
-        m_AvailableDevices,
-        m_AvailableDeviceOptions,
-        m_DeviceConfigStore,
-        [this](const std::string& deviceName, const std::string& option, const std::string& value) {
-            send_device_config_add(deviceName, option, value);
-        },
-        sigc::mem_fun(*this, &ConfigWindow::setup_device_name),
-        sigc::mem_fun(*this, &ConfigWindow::setup_device_option),
-        sigc::mem_fun(*this, &ConfigWindow::setup_device_value),
-        sigc::mem_fun(*this, &ConfigWindow::bind_device_name),
-        sigc::mem_fun(*this, &ConfigWindow::bind_device_option),
-        sigc::mem_fun(*this, &ConfigWindow::bind_device_value));
-
-    Gtk::Box* mainBox = m_DevicesPanel->widget();
-    m_ContentVBox.append(*mainBox);
-    m_SectionWidgets[sectionPath] = mainBox;
-    m_OrderedSections.push_back({sectionPath, mainBox});
+    add_section_slot("__device_configs__", kKeywordPanelHeight);
+}
+
+void ConfigWindow::add_section_slot(const std::string& sectionPath, int placeholderHeight) {
+    auto slot = std::make_unique<ui::SectionSlot>(placeholderHeight);
+    Gtk::Box* slotBox = slot->widget();
+    m_ContentVBox.append(*slotBox);
+    m_SectionWidgets[sectionPath] = slotBox;
+    m_OrderedSections.push_back({sectionPath, slotBox});
+    m_SectionSlots[sectionPath] = std::move(slot);
+}
+
+bool ConfigWindow::realize_section(const std::string& sectionPath) {
+    auto slot = m_SectionSlots.find(sectionPath);
+    if (slot == m_SectionSlots.end() || slot->second->is_realized()) {
+        return false;
+    }
+
+    HYPRLAND_TRACE_SPAN_DETAIL("window.realize_section", sectionPath);
+    Gtk::Box* content = nullptr;
+    if (sectionPath == "__executing__") {
+        m_ExecutingPanel = std::make_unique<ui::KeywordsPanel>(
+            ui::KeywordsPanel::Kind::Executing,
+            m_ExecutingStore,
+            [this](const std::string& type, const std::string& value) { send_keyword_add(type, value); },
+            sigc::mem_fun(*this, &ConfigWindow::setup_keyword_type),
+            sigc::mem_fun(*this, &ConfigWindow::setup_keyword_value),
+            sigc::mem_fun(*this, &ConfigWindow::bind_keyword_type),
+            sigc::mem_fun(*this, &ConfigWindow::bind_keyword_value));
+        content = m_ExecutingPanel->widget();
+    } else if (sectionPath == "__env_vars__") {
+        m_EnvVarsPanel = std::make_unique<ui::KeywordsPanel>(
+            ui::KeywordsPanel::Kind::EnvironmentVariables,
+            m_EnvVarStore,
+            [this](const std::string& type, const std::string& value) { send_keyword_add(type, value); },
+            sigc::mem_fun(*this, &ConfigWindow::setup_keyword_type),
+            sigc::mem_fun(*this, &ConfigWindow::setup_keyword_value),
+            sigc::mem_fun(*this, &ConfigWindow::bind_keyword_type),
+            sigc::mem_fun(*this, &ConfigWindow::bind_keyword_value));
+        content = m_EnvVarsPanel->widget();
+    } else if (sectionPath == "__device_configs__") {
+        m_DevicesPanel = std::make_unique<ui::DevicesPanel>(
+            m_AvailableDevices,
+            m_DeviceSchema,
+            m_Snapshot.options,
+            m_ContentScroll,
+            m_DeviceConfigStore,
+            [this](const std::string& deviceName, const std::string& option, const std::string& value) {
+                return send_device_config_add(deviceName, option, value);
+            },
+            sigc::mem_fun(*this, &ConfigWindow::setup_device_name),
+            sigc::mem_fun(*this, &ConfigWindow::setup_device_option),
+            sigc::mem_fun(*this, &ConfigWindow::setup_device_value),
+            sigc::mem_fun(*this, &ConfigWindow::bind_device_name),
+            sigc::mem_fun(*this, &ConfigWindow::bind_device_option),
+            sigc::mem_fun(*this, &ConfigWindow::bind_device_value));
+        content = m_DevicesPanel->widget();
+    } else {
+        auto store = m_SectionStores.find(sectionPath);
+        if (store == m_SectionStores.end()) {
+            return false;
+        }
+
+        populate_section(sectionPath);
+        auto panel = std::make_unique<ui::VariablesPanel>(
+            sectionPath,
+            Gtk::FilterListModel::create(store->second, m_OptionFilter),
+            sigc::mem_fun(*this, &ConfigWindow::setup_column_read),
+            sigc::mem_fun(*this, &ConfigWindow::setup_column_edit),
+            sigc::mem_fun(*this, &ConfigWindow::bind_name),
+            sigc::mem_fun(*this, &ConfigWindow::bind_value));
+        content = panel->widget();
+        m_VariablesPanels[sectionPath] = std::move(panel);
+    }
+
+    slot->second->realize(*content);
+    return true;
+}
+
+void ConfigWindow::evict_section(const std::string& sectionPath) {
+    auto slot = m_SectionSlots.find(sectionPath);
+    if (slot == m_SectionSlots.end() || !slot->second->is_realized()) {
+        return;
+    }
+
+    slot->second->evict();
+    if (sectionPath == "__executing__") {
+        m_ExecutingPanel.reset();
+    } else if (sectionPath == "__env_vars__") {
+        m_EnvVarsPanel.reset();
+    } else if (sectionPath == "__device_configs__") {
+        m_DevicesPanel.reset();
+    } else {
+        m_VariablesPanels.erase(sectionPath);
+    }
+}
+
+void ConfigWindow::evict_all_sections() {
+    for (const auto& section : m_OrderedSections) {
+        evict_section(section.first);
+    }
+}
+
+void ConfigWindow::update_realized_sections() {
+    if (m_MainStack.get_visible_child_name() != "content") {
+        return;
+    }
+
+    auto vadj = m_ContentScroll.get_vadjustment();
+    const double page = (vadj && vadj->get_page_size() > 0.0) ? vadj->get_page_size() : 800.0;
+    const double top = vadj ? vadj->get_value() : 0.0;
+
+    // Build one page ahead and behind; keep built panels until they are
+    // several pages away so scrolling back and forth does not thrash.
+    const double realizeTop = top - page;
+    const double realizeBottom = top + 2.0 * page;
+    const double keepTop = top - 4.0 * page;
+    const double keepBottom = top + 5.0 * page;
+
+    for (const auto& section : m_OrderedSections) {
+        double x;
+        double y;
+        if (!section.second->translate_coordinates(m_ContentVBox, 0, 0, x, y)) {
+            continue;
+        }
+
+        const double bottom = y + section.second->get_height();
+        if (bottom >= realizeTop && y <= realizeBottom) {
+            realize_section(section.first);
+        } else if (bottom < keepTop || y > keepBottom) {
+            evict_section(section.first);
+        }
+    }
+}
+
+void ConfigWindow::realize_first_page() {
+    const int viewport = m_ContentScroll.get_height() > 0 ? m_ContentScroll.get_height() : 800;
+    int filled = 0;
+    for (const auto& section : m_OrderedSections) {
+        if (filled > viewport) {
+            break;
+        }
+        int width = -1;
+        int height = -1;
+        section.second->get_size_request(width, height);
+        filled += height > 0 ? height : kSectionHeaderHeight;
+        realize_section(section.first);
+    }
 }
 
 void ConfigWindow::setup_column_read(const Glib::RefPtr<Gtk::ListItem>& list_item) {
+    HYPRLAND_TRACE_SPAN("view.setup_name");
     ui::setup_option_name_cell(list_item, *this);
 }
 
 void ConfigWindow::setup_column_edit(const Glib::RefPtr<Gtk::ListItem>& list_item) {
+    HYPRLAND_TRACE_SPAN("view.setup_value");
     ui::setup_option_value_editor(
         list_item,
         m_ContentScroll,
         m_binding_programmatically,
-        [this](const std::string& name, const std::string& value) { send_update(name, value); },
-        [this](const std::string& name, const std::string& value) { send_runtime_update(name, value); });
+        [this](const std::string& name, const core::OptionValue& value) { return send_update(name, value); },
+        [this](const std::string& name, const core::OptionValue& value) { send_runtime_update(name, value); },
+        [this](size_t index) { reset_option(index); });
 }
 
 void ConfigWindow::bind_name(const Glib::RefPtr<Gtk::ListItem>& list_item) {
+    HYPRLAND_TRACE_SPAN("view.bind_name");
     ui::bind_option_name_cell(list_item);
 }
 
 void ConfigWindow::bind_value(const Glib::RefPtr<Gtk::ListItem>& list_item) {
+    HYPRLAND_TRACE_SPAN("view.bind_value");
     ui::bind_option_value_editor(list_item, m_binding_programmatically);
 }
 
@@ -0,0 +1,46 @@
+#include "core/choice_list.hpp"
+
+#include "core/value_codec.hpp"
+
+#include <unordered_map>
+
+namespace core {
+ChoiceList::ChoiceList(const std::string& csv) {
+    // Empty labels are skipped but still take up an index.
+    size_t start = 0;
+    size_t index = 0;
+    while (start <= csv.size()) {
+        const size_t end = csv.find(',', start);
+        const std::string token = (end == std::string::npos)
+            ? csv.substr(start)
+            : csv.substr(start, end - start);
+        std::string label = trim_copy(token);
+        if (!label.empty()) {
+            m_entries.push_back({std::to_string(index), std::move(label)});
+        }
+        ++index;
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+}
+
+size_t ChoiceList::find(const std::string& value) const {
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].value == value) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+std::shared_ptr<const ChoiceList> shared_choice_list(const std::string& csv) {
+    static std::unordered_map<std::string, std::shared_ptr<const ChoiceList>> lists;
+    auto it = lists.find(csv);
+    if (it == lists.end()) {
+        it = lists.emplace(csv, std::make_shared<const ChoiceList>(csv)).first;
+    }
+    return it->second;
+}
+}  // namespace core
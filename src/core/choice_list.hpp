@@ -0,0 +1,41 @@
+#ifndef CORE_CHOICE_LIST_HPP
+#define CORE_CHOICE_LIST_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace core {
+struct Choice {
+    // Index Hyprland expects, as text.
+    std::string value;
+    std::string label;
+};
+
+class ChoiceList {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    explicit ChoiceList(const std::string& csv);
+
+    const std::vector<Choice>& entries() const { return m_entries; }
+    bool empty() const { return m_entries.empty(); }
+    size_t size() const { return m_entries.size(); }
+    const Choice& operator[](size_t index) const { return m_entries[index]; }
+
+    // Position of the entry whose value is `value`, or npos.
+    size_t find(const std::string& value) const;
+
+private:
+    std::vector<Choice> m_entries;
+};
+
+// Parsed list for a `data.value` CSV from Hyprland. Lists are memoized by the
+// CSV text for the life of the process, so options with the same choices share
+// one list and refreshes reuse it. Lists are first needed when a row binds,
+// so the cache is only used from the UI thread and takes no lock.
+std::shared_ptr<const ChoiceList> shared_choice_list(const std::string& csv);
+}  // namespace core
+
+#endif
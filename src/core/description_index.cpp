@@ -0,0 +1,231 @@
+#include "core/description_index.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string_view>
+
+namespace {
+constexpr char kCacheMagic[8] = {'H', 'S', 'D', 'I', 'D', 'X', '0', '1'};
+
+bool is_stop_word(std::string_view token) {
+    static constexpr std::string_view kStopWords[] = {
+        "an", "and", "are", "as", "be", "by", "for", "if", "in", "is", "it",
+        "of", "on", "or", "the", "this", "that", "to", "when", "will", "with",
+    };
+    return std::find(std::begin(kStopWords), std::end(kStopWords), token) != std::end(kStopWords);
+}
+
+template <typename Callback>
+void for_each_token(std::string_view text, Callback&& callback) {
+    std::string token;
+    for (size_t i = 0; i <= text.size(); ++i) {
+        const unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+        if (std::isalnum(c) != 0) {
+            token.push_back(static_cast<char>(std::tolower(c)));
+            continue;
+        }
+        if (token.size() >= 2 && !is_stop_word(token)) {
+            callback(token);
+        }
+        token.clear();
+    }
+}
+
+template <typename T>
+void write_pod(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool read_pod(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+// Bytes between the read position and the end, or -1 when the stream cannot
+// seek.
+std::streamoff remaining_bytes(std::istream& in) {
+    const std::streampos position = in.tellg();
+    if (position < 0 || !in.seekg(0, std::ios::end)) {
+        return -1;
+    }
+    const std::streampos end = in.tellg();
+    in.seekg(position);
+    return end < position ? -1 : static_cast<std::streamoff>(end - position);
+}
+}
+
+namespace core {
+DescriptionIndex::DescriptionIndex(const std::vector<std::string>& descriptions)
+    : m_optionCount(static_cast<uint32_t>(descriptions.size())) {
+    std::map<std::string, std::vector<Posting>> postings;
+    for (uint32_t option = 0; option < m_optionCount; ++option) {
+        for_each_token(descriptions[option], [&](const std::string& token) {
+            auto& list = postings[token];
+            if (!list.empty() && list.back().option == option) {
+                ++list.back().frequency;
+            } else {
+                list.push_back({option, 1});
+            }
+        });
+    }
+
+    m_terms.reserve(postings.size());
+    m_postingOffsets.reserve(postings.size() + 1);
+    for (auto& entry : postings) {
+        m_terms.push_back(entry.first);
+        m_postingOffsets.push_back(static_cast<uint32_t>(m_postings.size()));
+        m_postings.insert(m_postings.end(), entry.second.begin(), entry.second.end());
+    }
+    m_postingOffsets.push_back(static_cast<uint32_t>(m_postings.size()));
+}
+
+size_t DescriptionIndex::option_count() const {
+    return m_optionCount;
+}
+
+size_t DescriptionIndex::term_count() const {
+    return m_terms.size();
+}
+
+std::vector<SearchMatch> DescriptionIndex::search(const std::string& query) const {
+    std::vector<std::string> words;
+    for_each_token(query, [&words](const std::string& token) { words.push_back(token); });
+    if (words.empty() || m_terms.empty()) {
+        return {};
+    }
+
+    // Per option: summed frequency, and how many query words it has matched.
+    std::vector<uint32_t> frequency(m_optionCount, 0);
+    std::vector<uint32_t> matchedWords(m_optionCount, 0);
+    std::vector<uint32_t> lastWord(m_optionCount, UINT32_MAX);
+    for (uint32_t w = 0; w < words.size(); ++w) {
+        const std::string& word = words[w];
+        auto term = std::lower_bound(m_terms.begin(), m_terms.end(), word);
+        for (; term != m_terms.end() && term->compare(0, word.size(), word) == 0; ++term) {
+            const size_t t = static_cast<size_t>(term - m_terms.begin());
+            for (uint32_t p = m_postingOffsets[t]; p < m_postingOffsets[t + 1]; ++p) {
+                const Posting& posting = m_postings[p];
+                frequency[posting.option] += posting.frequency;
+                if (lastWord[posting.option] != w) {
+                    lastWord[posting.option] = w;
+                    ++matchedWords[posting.option];
+                }
+            }
+        }
+    }
+
+    std::vector<SearchMatch> matches;
+    for (uint32_t option = 0; option < m_optionCount; ++option) {
+        if (matchedWords[option] == words.size()) {
+            matches.push_back({option, static_cast<int>(frequency[option])});
+        }
+    }
+    std::stable_sort(matches.begin(), matches.end(), [](const SearchMatch& a, const SearchMatch& b) {
+        return a.score > b.score;
+    });
+    return matches;
+}
+
+void DescriptionIndex::save(std::ostream& out) const {
+    out.write(kCacheMagic, sizeof(kCacheMagic));
+    write_pod(out, m_optionCount);
+    write_pod(out, static_cast<uint32_t>(m_terms.size()));
+    for (const auto& term : m_terms) {
+        write_pod(out, static_cast<uint32_t>(term.size()));
+        out.write(term.data(), static_cast<std::streamsize>(term.size()));
+    }
+    for (uint32_t offset : m_postingOffsets) {
+        write_pod(out, offset);
+    }
+    for (const auto& posting : m_postings) {
+        write_pod(out, posting.option);
+        write_pod(out, posting.frequency);
+    }
+}
+
+bool DescriptionIndex::load(std::istream& in) {
+    char magic[sizeof(kCacheMagic)] = {};
+    if (!in.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), kCacheMagic)) {
+        return false;
+    }
+
+    DescriptionIndex loaded;
+    uint32_t termCount = 0;
+    if (!read_pod(in, loaded.m_optionCount) || !read_pod(in, termCount)) {
+        return false;
+    }
+
+    // Counts come from the file, so they are checked against what is left of
+    // it before anything is allocated: each term takes at least its length
+    // field and its offset.
+    const std::streamoff remaining = remaining_bytes(in);
+    const uint64_t minimumTermBytes = (static_cast<uint64_t>(termCount) * 2 + 1) * sizeof(uint32_t);
+    if (remaining < 0 || minimumTermBytes > static_cast<uint64_t>(remaining)) {
+        return false;
+    }
+
+    loaded.m_terms.resize(termCount);
+    for (auto& term : loaded.m_terms) {
+        uint32_t length = 0;
+        if (!read_pod(in, length) || length > 4096) {
+            return false;
+        }
+        term.resize(length);
+        if (!in.read(term.data(), length)) {
+            return false;
+        }
+    }
+    // search() relies on the vocabulary being sorted and unique.
+    if (std::adjacent_find(loaded.m_terms.begin(), loaded.m_terms.end(),
+                           [](const std::string& a, const std::string& b) { return !(a < b); }) !=
+        loaded.m_terms.end()) {
+        return false;
+    }
+
+    loaded.m_postingOffsets.resize(static_cast<size_t>(termCount) + 1);
+    for (auto& offset : loaded.m_postingOffsets) {
+        if (!read_pod(in, offset)) {
+            return false;
+        }
+    }
+    if (loaded.m_postingOffsets.front() != 0 ||
+        !std::is_sorted(loaded.m_postingOffsets.begin(), loaded.m_postingOffsets.end())) {
+        return false;
+    }
+
+    const std::streamoff postingBytes = remaining_bytes(in);
+    if (postingBytes < 0 ||
+        static_cast<uint64_t>(loaded.m_postingOffsets.back()) * 2 * sizeof(uint32_t) >
+            static_cast<uint64_t>(postingBytes)) {
+        return false;
+    }
+
+    loaded.m_postings.resize(loaded.m_postingOffsets.back());
+    for (auto& posting : loaded.m_postings) {
+        if (!read_pod(in, posting.option) || !read_pod(in, posting.frequency) ||
+            posting.option >= loaded.m_optionCount) {
+            return false;
+        }
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+uint64_t DescriptionIndex::fingerprint(const std::vector<std::string>& descriptions) {
+    // FNV-1a over every description, with a separator so boundaries count.
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto& description : descriptions) {
+        for (char c : description) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+        hash ^= 0xff;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+}  // namespace core
@@ -0,0 +1,50 @@
+#ifndef CORE_DESCRIPTION_INDEX_HPP
+#define CORE_DESCRIPTION_INDEX_HPP
+
+#include "core/option_search_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace core {
+// Inverted index over option descriptions: a sorted vocabulary of lowercase
+// word tokens, each pointing at the options whose description contains it
+// and how often. Queries never touch the description text itself.
+class DescriptionIndex {
+public:
+    DescriptionIndex() = default;
+    explicit DescriptionIndex(const std::vector<std::string>& descriptions);
+
+    size_t option_count() const;
+    size_t term_count() const;
+
+    // Options whose description mentions every query word (a word matches any
+    // token it is a prefix of, so "gap" finds "gaps"), ranked by summed term
+    // frequency.
+    std::vector<SearchMatch> search(const std::string& query) const;
+
+    void save(std::ostream& out) const;
+    // Leaves the index unchanged and returns false on a truncated or
+    // inconsistent cache. The stream must be seekable.
+    bool load(std::istream& in);
+
+    static uint64_t fingerprint(const std::vector<std::string>& descriptions);
+
+private:
+    struct Posting {
+        uint32_t option = 0;
+        uint32_t frequency = 0;
+    };
+
+    uint32_t m_optionCount = 0;
+    std::vector<std::string> m_terms;
+    // Postings of m_terms[i] are m_postings[m_postingOffsets[i] .. m_postingOffsets[i + 1]).
+    std::vector<uint32_t> m_postingOffsets;
+    std::vector<Posting> m_postings;
+};
+}  // namespace core
+
+#endif
@@ -0,0 +1,113 @@
+#include "core/event_ring.hpp"
+
+#include <cstring>
+
+namespace {
+static_assert((core::EventRing::kCapacity & (core::EventRing::kCapacity - 1)) == 0,
+              "capacity must be a power of two");
+
+uint64_t to_ns(std::chrono::steady_clock::duration duration) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    return ns > 0 ? static_cast<uint64_t>(ns) : 0;
+}
+
+// A slot holding event n reads 2n + 1 while being written and 2n + 2 once
+// complete, so a zeroed slot never looks complete.
+uint64_t writing(uint64_t sequence) {
+    return 2 * sequence + 1;
+}
+
+uint64_t written(uint64_t sequence) {
+    return 2 * sequence + 2;
+}
+}  // namespace
+
+namespace core {
+const char* event_kind_name(EventKind kind) {
+    switch (kind) {
+    case EventKind::Keyword: return "keyword";
+    case EventKind::Descriptions: return "descriptions";
+    case EventKind::Devices: return "devices";
+    case EventKind::ConfigWrite: return "config write";
+    case EventKind::GetOption: return "getoption";
+    case EventKind::PersistentUpdate: return "apply";
+    case EventKind::RuntimeUpdate: return "preview";
+    case EventKind::CoalescedUpdate: return "coalesced";
+    case EventKind::LoadData: return "load";
+    }
+    return "unknown";
+}
+
+void EventRing::push(EventKind kind, std::string_view name, Clock::time_point start, Clock::time_point end,
+                     bool ok) {
+    const uint64_t sequence = m_head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = m_slots[sequence & (kCapacity - 1)];
+
+    slot.sequence.store(writing(sequence), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.timestamp_ns.store(to_ns(start.time_since_epoch()), std::memory_order_relaxed);
+    slot.duration_ns.store(to_ns(end - start), std::memory_order_relaxed);
+    slot.kind_and_ok.store(static_cast<uint32_t>(kind) << 1 | (ok ? 1u : 0u), std::memory_order_relaxed);
+
+    char text[kNameWords * sizeof(uint64_t)] = {};
+    std::memcpy(text, name.data(), name.size() < kMaxNameLength ? name.size() : kMaxNameLength);
+    for (size_t i = 0; i < kNameWords; ++i) {
+        uint64_t word;
+        std::memcpy(&word, text + i * sizeof(uint64_t), sizeof(word));
+        slot.name[i].store(word, std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(written(sequence), std::memory_order_release);
+}
+
+void EventRing::push(EventKind kind, std::string_view name, Clock::time_point start, bool ok) {
+    push(kind, name, start, Clock::now(), ok);
+}
+
+uint64_t EventRing::head() const {
+    return m_head.load(std::memory_order_acquire);
+}
+
+std::vector<Event> EventRing::snapshot(uint64_t since) const {
+    const uint64_t end = head();
+    uint64_t begin = end > kCapacity ? end - kCapacity : 0;
+    begin = since > begin ? since : begin;
+
+    std::vector<Event> events;
+    events.reserve(static_cast<size_t>(end - begin));
+    for (uint64_t sequence = begin; sequence < end; ++sequence) {
+        const Slot& slot = m_slots[sequence & (kCapacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != written(sequence)) {
+            continue;  // Still being written, or already overwritten.
+        }
+
+        Event event;
+        event.sequence = sequence;
+        event.timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+        event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+        const uint32_t kindAndOk = slot.kind_and_ok.load(std::memory_order_relaxed);
+        event.kind = static_cast<EventKind>(kindAndOk >> 1);
+        event.ok = (kindAndOk & 1u) != 0;
+
+        char text[kNameWords * sizeof(uint64_t)];
+        for (size_t i = 0; i < kNameWords; ++i) {
+            const uint64_t word = slot.name[i].load(std::memory_order_relaxed);
+            std::memcpy(text + i * sizeof(uint64_t), &word, sizeof(word));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != written(sequence)) {
+            continue;
+        }
+        event.name.assign(text, strnlen(text, sizeof(text)));
+        events.push_back(std::move(event));
+    }
+    return events;
+}
+
+EventRing& event_ring() {
+    static EventRing ring;
+    return ring;
+}
+}  // namespace core
@@ -0,0 +1,80 @@
+#ifndef CORE_EVENT_RING_HPP
+#define CORE_EVENT_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+enum class EventKind : uint8_t {
+    Keyword,
+    Descriptions,
+    Devices,
+    ConfigWrite,
+    GetOption,
+    PersistentUpdate,
+    RuntimeUpdate,
+    CoalescedUpdate,
+    LoadData,
+};
+
+const char* event_kind_name(EventKind kind);
+
+struct Event {
+    uint64_t sequence = 0;
+    // Nanoseconds on the steady clock when the event started.
+    uint64_t timestamp_ns = 0;
+    uint64_t duration_ns = 0;
+    EventKind kind = EventKind::Keyword;
+    bool ok = true;
+    std::string name;
+};
+
+// Fixed-size ring of recent events. Any thread may push without blocking;
+// once full, the oldest events are overwritten. Each slot is a seqlock, so a
+// reader skips slots that are mid-write instead of waiting for them.
+class EventRing {
+public:
+    static constexpr size_t kCapacity = 1024;
+    // Longer names are truncated.
+    static constexpr size_t kMaxNameLength = 63;
+
+    using Clock = std::chrono::steady_clock;
+
+    void push(EventKind kind, std::string_view name, Clock::time_point start, Clock::time_point end,
+              bool ok);
+    // Convenience for an event that ends now.
+    void push(EventKind kind, std::string_view name, Clock::time_point start, bool ok);
+
+    // Sequence number the next event will get; also the number pushed so far.
+    uint64_t head() const;
+    // Events with sequence >= since that are still in the ring, oldest first.
+    std::vector<Event> snapshot(uint64_t since = 0) const;
+
+private:
+    static constexpr size_t kNameWords = (kMaxNameLength + 1) / sizeof(uint64_t);
+
+    // Every field is atomic so a reader racing a writer is well defined; the
+    // sequence tells it whether what it read was consistent.
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> timestamp_ns{0};
+        std::atomic<uint64_t> duration_ns{0};
+        std::atomic<uint32_t> kind_and_ok{0};
+        std::array<std::atomic<uint64_t>, kNameWords> name{};
+    };
+
+    std::atomic<uint64_t> m_head{0};
+    std::array<Slot, kCapacity> m_slots;
+};
+
+// Ring shared by the backend and the UI.
+EventRing& event_ring();
+}  // namespace core
+
+#endif
@@ -0,0 +1,210 @@
+#include "core/metrics.hpp"
+
+#include <cstdio>
+
+namespace {
+struct OperationStats {
+    core::LatencyHistogram latency;
+    std::atomic<uint64_t> failures{0};
+};
+
+std::array<OperationStats, core::metrics::kOperationCount>& operation_stats() {
+    static std::array<OperationStats, core::metrics::kOperationCount> stats;
+    return stats;
+}
+
+std::array<std::atomic<uint64_t>, core::metrics::kCounterCount>& counters() {
+    static std::array<std::atomic<uint64_t>, core::metrics::kCounterCount> values{};
+    return values;
+}
+
+unsigned highest_bit(uint64_t value) {
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+}
+}  // namespace
+
+namespace core {
+size_t LatencyHistogram::bucket_index(uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+    // The top kSubBucketBits + 1 bits pick the bucket; the leading one is
+    // implied by the octave.
+    const unsigned shift = highest_bit(value) - kSubBucketBits;
+    const size_t octave = shift + 1;
+    return octave * kSubBuckets + static_cast<size_t>((value >> shift) - kSubBuckets);
+}
+
+uint64_t LatencyHistogram::bucket_lowest(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const size_t octave = index / kSubBuckets;
+    return (kSubBuckets + index % kSubBuckets) << (octave - 1);
+}
+
+uint64_t LatencyHistogram::bucket_highest(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const size_t octave = index / kSubBuckets;
+    return bucket_lowest(index) + ((uint64_t{1} << (octave - 1)) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    m_buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t seen = m_max.load(std::memory_order_relaxed);
+    while (value > seen && !m_max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const {
+    return m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::sum() const {
+    return m_sum.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::max() const {
+    return m_max.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::quantile(double q) const {
+    // Sum the buckets rather than trusting m_count, which a concurrent
+    // record() may have bumped before its bucket.
+    uint64_t total = 0;
+    for (const auto& bucket : m_buckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    q = q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q);
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total) + 0.5);
+    rank = rank == 0 ? 1 : rank;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            const uint64_t highest = bucket_highest(i);
+            const uint64_t maxValue = max();
+            return maxValue != 0 && maxValue < highest ? maxValue : highest;
+        }
+    }
+    return max();
+}
+
+namespace metrics {
+const char* operation_name(Operation operation) {
+    switch (operation) {
+    case Operation::Keyword: return "keyword";
+    case Operation::Descriptions: return "descriptions";
+    case Operation::Devices: return "devices";
+    case Operation::ConfigWrite: return "config write";
+    case Operation::GetOption: return "getoption";
+    }
+    return "unknown";
+}
+
+const char* counter_name(Counter counter) {
+    switch (counter) {
+    case Counter::Retries: return "retries";
+    case Counter::CoalescedUpdates: return "coalesced updates";
+    case Counter::BytesRead: return "bytes read";
+    }
+    return "unknown";
+}
+
+void record(Operation operation, Clock::time_point start, bool ok) {
+    auto& stats = operation_stats()[static_cast<size_t>(operation)];
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    stats.latency.record(static_cast<uint64_t>(elapsed.count() > 0 ? elapsed.count() : 0));
+    if (!ok) {
+        stats.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void add(Counter counter, uint64_t amount) {
+    counters()[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+const LatencyHistogram& latency(Operation operation) {
+    return operation_stats()[static_cast<size_t>(operation)].latency;
+}
+
+uint64_t failures(Operation operation) {
+    return operation_stats()[static_cast<size_t>(operation)].failures.load(std::memory_order_relaxed);
+}
+
+uint64_t counter(Counter counter) {
+    return counters()[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+void reset() {
+    for (auto& stats : operation_stats()) {
+        stats.latency.reset();
+        stats.failures.store(0, std::memory_order_relaxed);
+    }
+    for (auto& value : counters()) {
+        value.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string format_duration(uint64_t ns) {
+    char text[32];
+    if (ns < 1000) {
+        std::snprintf(text, sizeof(text), "%llu ns", static_cast<unsigned long long>(ns));
+    } else if (ns < 1000000) {
+        std::snprintf(text, sizeof(text), "%.0f us", static_cast<double>(ns) / 1e3);
+    } else if (ns < 1000000000) {
+        std::snprintf(text, sizeof(text), "%.2f ms", static_cast<double>(ns) / 1e6);
+    } else {
+        std::snprintf(text, sizeof(text), "%.2f s", static_cast<double>(ns) / 1e9);
+    }
+    return text;
+}
+
+std::string format_report() {
+    std::string report;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-14s %8s %8s %10s %10s %10s %10s\n",
+                  "operation", "count", "failed", "p50", "p90", "p99", "max");
+    report += line;
+    for (size_t i = 0; i < kOperationCount; ++i) {
+        const auto operation = static_cast<Operation>(i);
+        const LatencyHistogram& histogram = latency(operation);
+        std::snprintf(line, sizeof(line), "%-14s %8llu %8llu %10s %10s %10s %10s\n",
+                      operation_name(operation),
+                      static_cast<unsigned long long>(histogram.count()),
+                      static_cast<unsigned long long>(failures(operation)),
+                      format_duration(histogram.quantile(0.50)).c_str(),
+                      format_duration(histogram.quantile(0.90)).c_str(),
+                      format_duration(histogram.quantile(0.99)).c_str(),
+                      format_duration(histogram.max()).c_str());
+        report += line;
+    }
+    for (size_t i = 0; i < kCounterCount; ++i) {
+        const auto which = static_cast<Counter>(i);
+        std::snprintf(line, sizeof(line), "%-18s %llu\n", counter_name(which),
+                      static_cast<unsigned long long>(counter(which)));
+        report += line;
+    }
+    return report;
+}
+}  // namespace metrics
+}  // namespace core
@@ -0,0 +1,85 @@
+#ifndef CORE_METRICS_HPP
+#define CORE_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace core {
+// Log-linear histogram in the style of HdrHistogram: 16 linear sub-buckets per
+// power of two, so any recorded value is reported within 1/16 of itself.
+// Recording is a few relaxed atomic adds and never blocks.
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t count() const;
+    uint64_t sum() const;
+    uint64_t max() const;
+    // Upper bound of the bucket holding the given quantile (0..1), or 0 when
+    // nothing was recorded.
+    uint64_t quantile(double q) const;
+
+    static size_t bucket_index(uint64_t value);
+    static uint64_t bucket_lowest(size_t index);
+    static uint64_t bucket_highest(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+// Process-wide backend metrics, shared by the UI, the transports and the
+// --metrics report.
+namespace metrics {
+enum class Operation {
+    Keyword,
+    Descriptions,
+    Devices,
+    ConfigWrite,
+    GetOption,
+};
+constexpr size_t kOperationCount = 5;
+
+enum class Counter {
+    // Requests resent after the compositor socket refused them.
+    Retries,
+    // Updates dropped because the value was already applied.
+    CoalescedUpdates,
+    // Reply bytes read from the compositor.
+    BytesRead,
+};
+constexpr size_t kCounterCount = 3;
+
+const char* operation_name(Operation operation);
+const char* counter_name(Counter counter);
+
+using Clock = std::chrono::steady_clock;
+
+// Latency in nanoseconds from start until now.
+void record(Operation operation, Clock::time_point start, bool ok);
+void add(Counter counter, uint64_t amount = 1);
+
+const LatencyHistogram& latency(Operation operation);
+uint64_t failures(Operation operation);
+uint64_t counter(Counter counter);
+void reset();
+
+// "412 us", "3.21 ms", "1.50 s".
+std::string format_duration(uint64_t ns);
+// Plain-text table of every operation and counter.
+std::string format_report();
+}  // namespace metrics
+}  // namespace core
+
+#endif
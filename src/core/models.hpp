@@ -1,13 +1,16 @@
 #ifndef CORE_MODELS_HPP
 #define CORE_MODELS_HPP
 
+#include <cstddef>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 struct ConfigOptionData {
     std::string name;
     std::string value;
+    std::string default_value;
     std::string description;
     std::string choice_values_csv;
     bool set_by_user = false;
@@ -23,8 +26,28 @@ struct ConfigOptionData {
     std::string section_path;
 };
 
+// An option's current value as `getoption` reports it, not yet normalized.
+struct OptionState {
+    std::string name;
+    std::string value;
+    bool set_by_user = false;
+};
+
+// The `hyprctl devices` group a device is listed in, which decides the
+// options its device block accepts. Touchpads are listed with the mice.
+enum class DeviceClass { Keyboard, Pointer, Touch, Tablet };
+constexpr size_t kDeviceClassCount = 4;
+
+struct InputDevice {
+    std::string name;
+    DeviceClass device_class = DeviceClass::Pointer;
+};
+
+// Option name and value pairs, in the order they are applied.
+using OptionAssignments = std::vector<std::pair<std::string, std::string>>;
+
 struct SettingsSnapshot {
-    std::vector<std::string> available_devices;
+    std::vector<InputDevice> available_devices;
     std::set<std::string> sections;
     std::vector<ConfigOptionData> options;
     bool has_root_options = false;
@@ -0,0 +1,114 @@
+#include "core/numeric_codec.hpp"
+
+namespace {
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+std::string_view trim_view(std::string_view text) {
+    while (!text.empty() && is_space(text.front())) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && is_space(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// from_chars rejects a leading '+', which hand-written configs use.
+std::string_view strip_plus(std::string_view text) {
+    if (text.size() > 1 && text.front() == '+' && text[1] != '-' && text[1] != '+') {
+        text.remove_prefix(1);
+    }
+    return text;
+}
+}
+
+namespace core {
+std::optional<double> parse_number(std::string_view text) {
+    text = strip_plus(trim_view(text));
+    if (text.empty()) {
+        return std::nullopt;
+    }
+
+    double value = 0.0;
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    if (result.ec != std::errc() || result.ptr != end || !std::isfinite(value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<long long> parse_integer(std::string_view text) {
+    text = strip_plus(trim_view(text));
+    if (text.empty()) {
+        return std::nullopt;
+    }
+
+    long long value = 0;
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    if (result.ec != std::errc() || result.ptr != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<long long> parse_leading_integer(std::string_view text) {
+    text = strip_plus(trim_view(text));
+    if (text.empty()) {
+        return std::nullopt;
+    }
+
+    double value = 0.0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || !std::isfinite(value)) {
+        return std::nullopt;
+    }
+
+    const double truncated = std::trunc(value);
+    if (truncated < -9.2e18 || truncated > 9.2e18) {
+        return std::nullopt;
+    }
+    return static_cast<long long>(truncated);
+}
+
+NumberText format_integer(long long value) {
+    NumberText text;
+    auto result = std::to_chars(text.begin(), text.end(), value);
+    text.set_size(static_cast<size_t>(result.ptr - text.begin()));
+    return text;
+}
+
+NumberText format_shortest(double value) {
+    NumberText text;
+    if (value == 0.0) {
+        value = 0.0;  // Drops the sign of negative zero.
+    }
+    auto result = std::to_chars(text.begin(), text.end(), value);
+    text.set_size(result.ec == std::errc() ? static_cast<size_t>(result.ptr - text.begin()) : 0);
+    return text;
+}
+
+namespace detail {
+void trim_fraction_zeros(NumberText& text) {
+    std::string_view view = text.view();
+    size_t size = view.size();
+    if (view.find('.') != std::string_view::npos) {
+        while (size > 0 && view[size - 1] == '0') {
+            --size;
+        }
+        if (size > 0 && view[size - 1] == '.') {
+            --size;
+        }
+    }
+    // Rounding can leave "-0" behind.
+    if (size == 2 && view[0] == '-' && view[1] == '0') {
+        text.begin()[0] = '0';
+        size = 1;
+    }
+    text.set_size(size);
+}
+}  // namespace detail
+}  // namespace core
@@ -0,0 +1,66 @@
+#ifndef CORE_NUMERIC_CODEC_HPP
+#define CORE_NUMERIC_CODEC_HPP
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace core {
+// A formatted number held in a stack buffer, so formatting never allocates.
+class NumberText {
+public:
+    static constexpr size_t kCapacity = 64;
+
+    std::string_view view() const { return std::string_view(m_buffer.data(), m_size); }
+    std::string str() const { return std::string(view()); }
+
+    char* begin() { return m_buffer.data(); }
+    char* end() { return m_buffer.data() + kCapacity; }
+    void set_size(size_t size) { m_size = size; }
+
+private:
+    std::array<char, kCapacity> m_buffer{};
+    size_t m_size = 0;
+};
+
+// All parsing and formatting below uses std::from_chars/std::to_chars, so it
+// ignores the process locale and never throws.
+
+// The whole input, surrounding whitespace and a leading '+' aside, must be a
+// finite number.
+std::optional<double> parse_number(std::string_view text);
+// Like parse_number, but the number must be an integer.
+std::optional<long long> parse_integer(std::string_view text);
+// Leading number of the input truncated toward zero; trailing text is ignored.
+std::optional<long long> parse_leading_integer(std::string_view text);
+
+NumberText format_integer(long long value);
+// Shortest text that parses back to exactly `value`.
+NumberText format_shortest(double value);
+
+namespace detail {
+void trim_fraction_zeros(NumberText& text);
+}
+
+// Fixed notation with at most `MaxDecimals` fraction digits and trailing
+// zeros removed. Values too large for the buffer fall back to the shortest form.
+template <int MaxDecimals>
+NumberText format_fixed(double value) {
+    static_assert(MaxDecimals >= 0 && MaxDecimals <= 17, "unsupported precision");
+
+    NumberText text;
+    auto result = std::to_chars(text.begin(), text.end(), value, std::chars_format::fixed, MaxDecimals);
+    if (result.ec != std::errc()) {
+        return format_shortest(value);
+    }
+    text.set_size(static_cast<size_t>(result.ptr - text.begin()));
+    detail::trim_fraction_zeros(text);
+    return text;
+}
+}  // namespace core
+
+#endif
@@ -0,0 +1,98 @@
+#include "core/option_bitset.hpp"
+
+#include <algorithm>
+#include <bitset>
+
+namespace core {
+OptionBitset::OptionBitset(size_t size, bool value)
+    : m_size(size),
+      m_words((size + 63) / 64, value ? ~uint64_t{0} : uint64_t{0}) {
+    clear_tail();
+}
+
+size_t OptionBitset::size() const {
+    return m_size;
+}
+
+bool OptionBitset::test(size_t index) const {
+    return index < m_size && ((m_words[index / 64] >> (index % 64)) & 1U) != 0;
+}
+
+void OptionBitset::set(size_t index, bool value) {
+    if (index >= m_size) {
+        return;
+    }
+
+    const uint64_t bit = uint64_t{1} << (index % 64);
+    if (value) {
+        m_words[index / 64] |= bit;
+    } else {
+        m_words[index / 64] &= ~bit;
+    }
+}
+
+void OptionBitset::fill(bool value) {
+    std::fill(m_words.begin(), m_words.end(), value ? ~uint64_t{0} : uint64_t{0});
+    clear_tail();
+}
+
+size_t OptionBitset::count() const {
+    size_t total = 0;
+    for (uint64_t word : m_words) {
+        total += std::bitset<64>(word).count();
+    }
+    return total;
+}
+
+OptionBitset& OptionBitset::operator&=(const OptionBitset& other) {
+    const size_t words = std::min(m_words.size(), other.m_words.size());
+    for (size_t i = 0; i < words; ++i) {
+        m_words[i] &= other.m_words[i];
+    }
+    std::fill(m_words.begin() + static_cast<std::ptrdiff_t>(words), m_words.end(), 0);
+    return *this;
+}
+
+bool OptionBitset::is_subset_of(const OptionBitset& other) const {
+    for (size_t i = 0; i < m_words.size(); ++i) {
+        const uint64_t theirs = i < other.m_words.size() ? other.m_words[i] : 0;
+        if ((m_words[i] & ~theirs) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+OptionBitset& OptionBitset::operator|=(const OptionBitset& other) {
+    const size_t words = std::min(m_words.size(), other.m_words.size());
+    for (size_t i = 0; i < words; ++i) {
+        m_words[i] |= other.m_words[i];
+    }
+    clear_tail();
+    return *this;
+}
+
+OptionBitset OptionBitset::intersection(size_t size, std::initializer_list<const OptionBitset*> sets) {
+    return intersection(size, std::vector<const OptionBitset*>(sets));
+}
+
+OptionBitset OptionBitset::intersection(size_t size, const std::vector<const OptionBitset*>& sets) {
+    OptionBitset result(size, true);
+    for (size_t w = 0; w < result.m_words.size(); ++w) {
+        uint64_t word = result.m_words[w];
+        for (const OptionBitset* set : sets) {
+            if (set) {
+                word &= w < set->m_words.size() ? set->m_words[w] : 0;
+            }
+        }
+        result.m_words[w] = word;
+    }
+    return result;
+}
+
+void OptionBitset::clear_tail() {
+    if (m_size % 64 != 0 && !m_words.empty()) {
+        m_words.back() &= (uint64_t{1} << (m_size % 64)) - 1;
+    }
+}
+}  // namespace core
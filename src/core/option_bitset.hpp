@@ -0,0 +1,56 @@
+#ifndef CORE_OPTION_BITSET_HPP
+#define CORE_OPTION_BITSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace core {
+// Fixed-size bitset over option indices, stored as 64-bit words so filters
+// combine a word at a time.
+class OptionBitset {
+public:
+    OptionBitset() = default;
+    explicit OptionBitset(size_t size, bool value = false);
+
+    size_t size() const;
+    bool test(size_t index) const;
+    void set(size_t index, bool value = true);
+    void fill(bool value);
+    size_t count() const;
+
+    // Calls fn(index) for each set bit in ascending order. Empty words are
+    // skipped whole, so sparse sets cost little more than their population.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (size_t word = 0; word < m_words.size(); ++word) {
+            uint64_t bits = m_words[word];
+            while (bits != 0) {
+                fn(word * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // Whether every bit set here is set in other; bits past other's size count
+    // as clear.
+    bool is_subset_of(const OptionBitset& other) const;
+
+    OptionBitset& operator&=(const OptionBitset& other);
+    OptionBitset& operator|=(const OptionBitset& other);
+
+    // AND of every set in one pass over the words. Null entries are skipped,
+    // so unused filters can be passed as nullptr.
+    static OptionBitset intersection(size_t size, std::initializer_list<const OptionBitset*> sets);
+    static OptionBitset intersection(size_t size, const std::vector<const OptionBitset*>& sets);
+
+private:
+    void clear_tail();
+
+    size_t m_size = 0;
+    std::vector<uint64_t> m_words;
+};
+}  // namespace core
+
+#endif
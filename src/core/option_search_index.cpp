@@ -0,0 +1,176 @@
+#include "core/option_search_index.hpp"
+
+#include <algorithm>
+#include <string_view>
+
+namespace {
+char lower_ascii(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+uint64_t char_bit(char c) {
+    if (c >= 'a' && c <= 'z') return uint64_t{1} << (c - 'a');
+    if (c >= '0' && c <= '9') return uint64_t{1} << (26 + (c - '0'));
+    switch (c) {
+    case '_': return uint64_t{1} << 36;
+    case ':': return uint64_t{1} << 37;
+    case '.': return uint64_t{1} << 38;
+    case '-': return uint64_t{1} << 39;
+    case ' ': return 0;
+    default: return uint64_t{1} << 40;
+    }
+}
+
+uint64_t char_mask(std::string_view text) {
+    uint64_t mask = 0;
+    for (char c : text) {
+        mask |= char_bit(c);
+    }
+    return mask;
+}
+
+bool is_word_start(std::string_view text, size_t pos) {
+    if (pos == 0) return true;
+    const char prev = text[pos - 1];
+    return prev == ':' || prev == '_' || prev == '.' || prev == '-';
+}
+}
+
+namespace core {
+OptionSearchIndex::OptionSearchIndex(const std::vector<std::string>& names) {
+    size_t total = 0;
+    for (const auto& name : names) {
+        total += name.size();
+    }
+    m_haystack.reserve(total);
+    m_entries.reserve(names.size());
+    m_charMasks.reserve(names.size());
+
+    for (const auto& name : names) {
+        Entry entry;
+        entry.offset = static_cast<uint32_t>(m_haystack.size());
+        entry.length = static_cast<uint32_t>(name.size());
+        const size_t colon = name.rfind(':');
+        entry.short_offset = colon == std::string::npos ? 0 : static_cast<uint32_t>(colon + 1);
+
+        for (char c : name) {
+            m_haystack.push_back(lower_ascii(c));
+        }
+        m_charMasks.push_back(char_mask(std::string_view(m_haystack).substr(entry.offset, entry.length)));
+        m_entries.push_back(entry);
+    }
+}
+
+size_t OptionSearchIndex::size() const {
+    return m_entries.size();
+}
+
+std::string OptionSearchIndex::normalize_query(const std::string& rawQuery) {
+    std::string query;
+    query.reserve(rawQuery.size());
+    for (char c : rawQuery) {
+        if (c != ' ') {
+            query.push_back(lower_ascii(c));
+        }
+    }
+    return query;
+}
+
+const std::vector<SearchMatch>& OptionSearchIndex::search(const std::string& rawQuery) {
+    const std::string query = normalize_query(rawQuery);
+    if (query.empty()) {
+        m_lastQuery.clear();
+        m_candidates.clear();
+        m_results.clear();
+        return m_results;
+    }
+
+    const bool narrowing = !m_lastQuery.empty() && query.size() >= m_lastQuery.size() &&
+                           query.compare(0, m_lastQuery.size(), m_lastQuery) == 0;
+
+    if (!narrowing) {
+        // Pre-filter: a branch-free pass over the packed masks that the
+        // compiler can vectorize; only entries containing every query
+        // character survive to the scorer.
+        const uint64_t queryMask = char_mask(query);
+        const size_t count = m_charMasks.size();
+        std::vector<unsigned char> keep(count);
+        for (size_t i = 0; i < count; ++i) {
+            keep[i] = static_cast<unsigned char>((m_charMasks[i] & queryMask) == queryMask);
+        }
+
+        m_candidates.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (keep[i]) {
+                m_candidates.push_back(i);
+            }
+        }
+    }
+
+    m_results.clear();
+    size_t kept = 0;
+    for (size_t candidate : m_candidates) {
+        const int s = score(m_entries[candidate], query);
+        if (s > 0) {
+            m_candidates[kept++] = candidate;
+            m_results.push_back({candidate, s});
+        }
+    }
+    m_candidates.resize(kept);
+    m_lastQuery = query;
+
+    std::stable_sort(m_results.begin(), m_results.end(), [](const SearchMatch& a, const SearchMatch& b) {
+        return a.score > b.score;
+    });
+    return m_results;
+}
+
+int OptionSearchIndex::score(const Entry& entry, const std::string& query) const {
+    const std::string_view name(m_haystack.data() + entry.offset, entry.length);
+    const std::string_view shortName = name.substr(entry.short_offset);
+
+    // Fuzzy subsequence match: every query character must appear in order.
+    // Matches at word starts and runs of consecutive characters score higher;
+    // skipped characters cost a little.
+    int total = 0;
+    size_t pos = 0;
+    size_t previous = std::string_view::npos;
+    for (char c : query) {
+        const size_t found = name.find(c, pos);
+        if (found == std::string_view::npos) {
+            return 0;
+        }
+
+        total += 16;
+        if (previous != std::string_view::npos && found == previous + 1) {
+            total += 12;
+        } else if (previous != std::string_view::npos) {
+            total -= static_cast<int>(std::min<size_t>(found - previous - 1, 8));
+        }
+        if (is_word_start(name, found)) {
+            total += 10;
+        }
+        previous = found;
+        pos = found + 1;
+    }
+
+    // Whole-query substring hits outrank scattered ones, and hits in the short
+    // name outrank hits in the section path.
+    const size_t shortHit = shortName.find(query);
+    if (shortHit != std::string_view::npos) {
+        total += 120;
+        if (shortHit == 0) {
+            total += 60;
+            if (shortName.size() == query.size()) {
+                total += 200;
+            }
+        }
+    } else if (name.find(query) != std::string_view::npos) {
+        total += 80;
+    }
+
+    // Prefer shorter names when everything else is equal.
+    total -= static_cast<int>(std::min<size_t>(name.size() / 8, 8));
+    return std::max(total, 1);
+}
+}  // namespace core
@@ -0,0 +1,53 @@
+#ifndef CORE_OPTION_SEARCH_INDEX_HPP
+#define CORE_OPTION_SEARCH_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+struct SearchMatch {
+    size_t option = 0;
+    int score = 0;
+};
+
+// Fuzzy, ranked search over option names ("general:border_size") and their
+// short names ("border_size"). Names are lowercased once into one contiguous
+// buffer, and each carries a 64-bit mask of the characters it contains so a
+// query can discard most entries with a single AND before any scoring.
+class OptionSearchIndex {
+public:
+    OptionSearchIndex() = default;
+    explicit OptionSearchIndex(const std::vector<std::string>& names);
+
+    size_t size() const;
+
+    // The query as search matches it: lowercased, with spaces dropped. An
+    // empty result means the query matches nothing.
+    static std::string normalize_query(const std::string& query);
+
+    // Returns matches ordered by descending score. A query that extends the
+    // previous one only rescans the previous matches.
+    const std::vector<SearchMatch>& search(const std::string& query);
+
+private:
+    struct Entry {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        uint32_t short_offset = 0;
+    };
+
+    int score(const Entry& entry, const std::string& query) const;
+
+    std::string m_haystack;
+    std::vector<Entry> m_entries;
+    std::vector<uint64_t> m_charMasks;
+
+    std::string m_lastQuery;
+    std::vector<size_t> m_candidates;
+    std::vector<SearchMatch> m_results;
+};
+}  // namespace core
+
+#endif
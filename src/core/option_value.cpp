@@ -0,0 +1,113 @@
+#include "core/option_value.hpp"
+
+#include <cmath>
+#include <type_traits>
+
+namespace core {
+OptionValue OptionValue::decode(ValueType type, std::string_view raw) {
+    return dispatch_value_type(type, [type, raw](auto tag) {
+        using Traits = ValueTraits<decltype(tag)::value>;
+
+        OptionValue value;
+        value.m_type = type;
+        auto parsed = Traits::parse(raw);
+        if (parsed.has_value()) {
+            value.store(*parsed);
+            value.m_text = Traits::format(std::move(*parsed));
+        } else {
+            value.m_text = std::string(raw);
+            value.m_valid = false;
+        }
+        return value;
+    });
+}
+
+OptionValue OptionValue::from_bool(bool flag) {
+    OptionValue value;
+    value.m_type = ValueType::Bool;
+    value.m_payload = flag;
+    value.m_text = ValueTraits<ValueType::Bool>::format(flag);
+    return value;
+}
+
+OptionValue OptionValue::from_number(double number, bool as_float) {
+    OptionValue value;
+    value.m_text = format_range_value(number, as_float);
+    if (as_float) {
+        value.m_type = ValueType::Float;
+        value.m_payload = number;
+    } else {
+        value.m_type = ValueType::Int;
+        value.m_payload = static_cast<long long>(std::trunc(number));
+    }
+    return value;
+}
+
+OptionValue OptionValue::from_vec2(double x, double y, bool as_float) {
+    const bool fractional = as_float || has_fractional_component(x) || has_fractional_component(y);
+    OptionValue value;
+    value.m_type = ValueType::Vec2;
+    value.m_payload = Vec2{x, y};
+    value.m_text = format_vector_value(x, y, fractional);
+    return value;
+}
+
+bool OptionValue::is_numeric() const {
+    return std::holds_alternative<long long>(m_payload) || std::holds_alternative<double>(m_payload);
+}
+
+bool OptionValue::as_bool() const {
+    if (const bool* flag = std::get_if<bool>(&m_payload)) {
+        return *flag;
+    }
+    return as_number() != 0.0;
+}
+
+double OptionValue::as_number(double fallback) const {
+    if (const long long* integer = std::get_if<long long>(&m_payload)) {
+        return static_cast<double>(*integer);
+    }
+    if (const double* number = std::get_if<double>(&m_payload)) {
+        return *number;
+    }
+    return fallback;
+}
+
+OptionValue::Vec2 OptionValue::as_vec2() const {
+    if (const Vec2* vector = std::get_if<Vec2>(&m_payload)) {
+        return *vector;
+    }
+    return {};
+}
+
+template <ValueType T>
+bool OptionValue::equal_as(const OptionValue& other) const {
+    using Traits = ValueTraits<T>;
+    using Payload = typename Traits::Payload;
+
+    if constexpr (std::is_same_v<Payload, std::string>) {
+        return Traits::equal(m_text, other.m_text);
+    } else {
+        const Payload* lhs = std::get_if<Payload>(&m_payload);
+        const Payload* rhs = std::get_if<Payload>(&other.m_payload);
+        if (lhs == nullptr || rhs == nullptr) {
+            return m_text == other.m_text;
+        }
+        return Traits::equal(*lhs, *rhs);
+    }
+}
+
+bool OptionValue::operator==(const OptionValue& other) const {
+    if (m_type == other.m_type) {
+        return dispatch_value_type(m_type, [this, &other](auto tag) {
+            return equal_as<decltype(tag)::value>(other);
+        });
+    }
+
+    // Range editors produce plain numbers for options of other types.
+    if (is_numeric() && other.is_numeric()) {
+        return ValueTraits<ValueType::Float>::equal(as_number(), other.as_number());
+    }
+    return m_text == other.m_text;
+}
+}  // namespace core
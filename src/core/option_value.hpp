@@ -0,0 +1,62 @@
+#ifndef CORE_OPTION_VALUE_HPP
+#define CORE_OPTION_VALUE_HPP
+
+#include "core/value_codec.hpp"
+
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace core {
+// An option value decoded once from its string form. It keeps the canonical
+// text that editors show and that is sent back to Hyprland, plus the decoded
+// payload, so binding and comparing never re-parse or allocate.
+class OptionValue {
+public:
+    using Vec2 = core::Vec2;
+
+    OptionValue() = default;
+
+    // Values that do not parse as their type keep the raw text and no payload.
+    static OptionValue decode(ValueType type, std::string_view raw);
+    static OptionValue decode(int value_type, std::string_view raw) {
+        return decode(value_type_from_id(value_type), raw);
+    }
+    static OptionValue from_bool(bool value);
+    // Integer or float depending on `as_float`, formatted like the range editors.
+    static OptionValue from_number(double value, bool as_float);
+    static OptionValue from_vec2(double x, double y, bool as_float);
+
+    ValueType type() const { return m_type; }
+    const std::string& str() const { return m_text; }
+    bool is_valid() const { return m_valid; }
+    bool is_numeric() const;
+
+    bool as_bool() const;
+    double as_number(double fallback = 0.0) const;
+    Vec2 as_vec2() const;
+
+    bool operator==(const OptionValue& other) const;
+    bool operator!=(const OptionValue& other) const { return !(*this == other); }
+
+private:
+    // Text-like types carry no payload; their canonical text is the value.
+    using Payload = std::variant<std::monostate, bool, long long, double, Vec2>;
+
+    template <ValueType T>
+    bool equal_as(const OptionValue& other) const;
+
+    void store(bool value) { m_payload = value; }
+    void store(long long value) { m_payload = value; }
+    void store(double value) { m_payload = value; }
+    void store(const Vec2& value) { m_payload = value; }
+    void store(const std::string&) {}
+
+    ValueType m_type = ValueType::LongString;
+    Payload m_payload;
+    bool m_valid = true;
+    std::string m_text;
+};
+}  // namespace core
+
+#endif
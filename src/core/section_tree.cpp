@@ -0,0 +1,74 @@
+#include "core/section_tree.hpp"
+
+namespace core {
+SectionTree::SectionTree()
+    : m_root(std::make_unique<SectionNode>()) {}
+
+SectionNode& SectionTree::root() {
+    return *m_root;
+}
+
+const SectionNode& SectionTree::root() const {
+    return *m_root;
+}
+
+SectionNode& SectionTree::add_child(SectionNode& parent, const std::string& name,
+                                    const std::string& full_path) {
+    auto node = std::make_unique<SectionNode>();
+    node->name = name;
+    node->full_path = full_path;
+    node->index_in_parent = parent.children.size();
+    node->parent = &parent;
+
+    SectionNode* raw = node.get();
+    parent.children.push_back(std::move(node));
+    m_index[full_path] = raw;
+    return *raw;
+}
+
+SectionNode& SectionTree::insert_path(SectionNode& base, const std::string& section_path) {
+    SectionNode* parent = &base;
+    std::string current_path;
+    size_t start = 0;
+    while (start <= section_path.size()) {
+        size_t end = section_path.find(':', start);
+        if (end == std::string::npos) {
+            end = section_path.size();
+        }
+
+        if (end > start) {
+            const std::string part = section_path.substr(start, end - start);
+            if (!current_path.empty()) {
+                current_path += ':';
+            }
+            current_path += part;
+
+            auto it = m_index.find(current_path);
+            parent = (it != m_index.end()) ? it->second : &add_child(*parent, part, current_path);
+        }
+        start = end + 1;
+    }
+    return *parent;
+}
+
+void SectionTree::add_option(const std::string& full_path) {
+    auto it = m_index.find(full_path);
+    if (it == m_index.end()) {
+        return;
+    }
+
+    for (SectionNode* node = it->second; node != nullptr && node != m_root.get(); node = node->parent) {
+        ++node->option_count;
+    }
+}
+
+const SectionNode* SectionTree::find(const std::string& full_path) const {
+    auto it = m_index.find(full_path);
+    return it == m_index.end() ? nullptr : it->second;
+}
+
+void SectionTree::clear() {
+    m_index.clear();
+    m_root = std::make_unique<SectionNode>();
+}
+}  // namespace core
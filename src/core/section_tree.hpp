@@ -0,0 +1,45 @@
+#ifndef CORE_SECTION_TREE_HPP
+#define CORE_SECTION_TREE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+struct SectionNode {
+    std::string name;
+    std::string full_path;
+    // Options in this section and all of its descendants.
+    size_t option_count = 0;
+    size_t index_in_parent = 0;
+    SectionNode* parent = nullptr;
+    std::vector<std::unique_ptr<SectionNode>> children;
+};
+
+// Prefix tree of sidebar sections. Nodes live on the heap so pointers handed to
+// the UI stay valid until clear(), and every node is indexed by its full path.
+class SectionTree {
+public:
+    SectionTree();
+
+    SectionNode& root();
+    const SectionNode& root() const;
+
+    SectionNode& add_child(SectionNode& parent, const std::string& name, const std::string& full_path);
+    // Adds "a:b:c" below base, creating the "a" and "a:b" nodes on the way.
+    SectionNode& insert_path(SectionNode& base, const std::string& section_path);
+    // Counts one option in the section and every ancestor below the root.
+    void add_option(const std::string& full_path);
+
+    const SectionNode* find(const std::string& full_path) const;
+    void clear();
+
+private:
+    std::unique_ptr<SectionNode> m_root;
+    std::unordered_map<std::string, SectionNode*> m_index;
+};
+}  // namespace core
+
+#endif
@@ -0,0 +1,169 @@
+#include "core/trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+struct Event {
+    const char* name;
+    std::string detail;
+    uint64_t start_ns;
+    uint64_t end_ns;
+};
+
+// Each thread appends to its own buffer, so the only lock a span takes is
+// uncontended except while finish() is copying the buffer out.
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<Event> events;
+    uint32_t tid = 0;
+};
+
+std::atomic<bool> g_enabled{false};
+std::chrono::steady_clock::time_point g_origin = std::chrono::steady_clock::now();
+std::string g_outputPath;
+
+std::mutex g_buffersMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> g_buffers;
+
+ThreadBuffer& thread_buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->events.reserve(1024);
+        std::lock_guard<std::mutex> lock(g_buffersMutex);
+        created->tid = static_cast<uint32_t>(g_buffers.size() + 1);
+        g_buffers.push_back(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+void write_json_string(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out << escaped;
+            } else {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+// Trace timestamps are microseconds; keep the nanoseconds as decimals.
+void write_micros(std::ostream& out, uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out << text;
+}
+}  // namespace
+
+namespace core::trace {
+void start_from_env() {
+    const char* path = std::getenv("HYPRLAND_SETTINGS_TRACE");
+    if (!path || !*path) {
+        return;
+    }
+#ifdef HYPRLAND_SETTINGS_TRACING
+    g_outputPath = std::string(path) == "1" ? "trace.json" : path;
+    g_origin = std::chrono::steady_clock::now();
+    g_enabled = true;
+#else
+    std::cerr << "HYPRLAND_SETTINGS_TRACE is set but this build has no tracing; "
+                 "configure with -Dtracing=true\n";
+#endif
+}
+
+bool finish() {
+    if (!g_enabled.exchange(false)) {
+        return false;
+    }
+
+    std::ofstream out(g_outputPath, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Could not write trace to " << g_outputPath << '\n';
+        return false;
+    }
+
+    const long pid = static_cast<long>(getpid());
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    std::lock_guard<std::mutex> buffersLock(g_buffersMutex);
+    for (const auto& buffer : g_buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        for (const auto& event : buffer->events) {
+            out << (first ? "" : ",\n") << "{\"ph\":\"X\",\"cat\":\"hyprland-settings\",\"name\":";
+            first = false;
+            write_json_string(out, event.name);
+            out << ",\"pid\":" << pid << ",\"tid\":" << buffer->tid << ",\"ts\":";
+            write_micros(out, event.start_ns);
+            out << ",\"dur\":";
+            write_micros(out, event.end_ns - event.start_ns);
+            if (!event.detail.empty()) {
+                out << ",\"args\":{\"detail\":";
+                write_json_string(out, event.detail);
+                out << '}';
+            }
+            out << '}';
+        }
+        buffer->events.clear();
+    }
+    out << "\n]}\n";
+
+    std::cerr << "Wrote trace to " << g_outputPath << '\n';
+    return static_cast<bool>(out);
+}
+
+bool enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - g_origin)
+                                     .count());
+}
+
+void record(const char* name, uint64_t start_ns, uint64_t end_ns, std::string_view detail) {
+    if (!enabled()) {
+        return;
+    }
+    ThreadBuffer& buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back({name, std::string(detail), start_ns, end_ns});
+}
+
+Span::Span(const char* name, std::string_view detail) {
+    if (!enabled()) {
+        return;
+    }
+    m_name = name;
+    m_detail = detail;
+    m_start = now_ns();
+}
+
+Span::~Span() {
+    if (m_name) {
+        record(m_name, m_start, now_ns(), m_detail);
+    }
+}
+}  // namespace core::trace
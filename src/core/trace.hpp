@@ -0,0 +1,53 @@
+#ifndef CORE_TRACE_HPP
+#define CORE_TRACE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Scoped spans written as a Chrome trace (chrome://tracing, ui.perfetto.dev).
+// Spans are only compiled in with -Dtracing=true; recording then starts when
+// HYPRLAND_SETTINGS_TRACE names the output file ("1" means trace.json).
+namespace core::trace {
+// Reads HYPRLAND_SETTINGS_TRACE. Call once from main before any span.
+void start_from_env();
+// Writes everything recorded so far to the file named at start. Returns false
+// when tracing is off or the file cannot be written.
+bool finish();
+
+bool enabled();
+// Nanoseconds since start_from_env on a monotonic clock.
+uint64_t now_ns();
+// Records a finished span on the calling thread. Name must be a string
+// literal; detail is copied.
+void record(const char* name, uint64_t start_ns, uint64_t end_ns, std::string_view detail = {});
+
+class Span {
+public:
+    explicit Span(const char* name, std::string_view detail = {});
+    ~Span();
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+private:
+    const char* m_name = nullptr;
+    std::string m_detail;
+    uint64_t m_start = 0;
+};
+}  // namespace core::trace
+
+#define HYPRLAND_TRACE_CONCAT_INNER(a, b) a##b
+#define HYPRLAND_TRACE_CONCAT(a, b) HYPRLAND_TRACE_CONCAT_INNER(a, b)
+
+#ifdef HYPRLAND_SETTINGS_TRACING
+#define HYPRLAND_TRACE_SPAN(name) \
+    ::core::trace::Span HYPRLAND_TRACE_CONCAT(traceSpan, __COUNTER__)(name)
+#define HYPRLAND_TRACE_SPAN_DETAIL(name, detail) \
+    ::core::trace::Span HYPRLAND_TRACE_CONCAT(traceSpan, __COUNTER__)(name, detail)
+#else
+#define HYPRLAND_TRACE_SPAN(name) static_cast<void>(0)
+#define HYPRLAND_TRACE_SPAN_DETAIL(name, detail) static_cast<void>(0)
+#endif
+
+#endif
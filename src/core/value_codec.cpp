@@ -0,0 +1,252 @@
+#include "core/value_codec.hpp"
+
+#include "core/numeric_codec.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <initializer_list>
+#include <string_view>
+
+namespace {
+bool is_digits_only(const std::string& value) {
+    return !value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char c) {
+        return std::isdigit(c) != 0;
+    });
+}
+
+bool is_hex_digits_only(const std::string& value) {
+    return !value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char c) {
+        return std::isxdigit(c) != 0;
+    });
+}
+
+constexpr double kNumberTolerance = 1e-9;
+constexpr std::string_view kEmptyMarker = "[[EMPTY]]";
+
+std::string_view trim_view(std::string_view value) {
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front())) != 0) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back())) != 0) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+bool equals_ignore_case(std::string_view lhs, std::string_view rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](unsigned char a, unsigned char b) {
+               return std::tolower(a) == std::tolower(b);
+           });
+}
+
+std::string lower_copy(const std::string& value) {
+    std::string out = value;
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return out;
+}
+}
+
+namespace core {
+std::string trim_copy(const std::string& value) {
+    size_t start = 0;
+    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start])) != 0) {
+        ++start;
+    }
+
+    size_t end = value.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1])) != 0) {
+        --end;
+    }
+
+    return value.substr(start, end - start);
+}
+
+std::string collapse_whitespace(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    bool previous_was_space = false;
+    for (char c : value) {
+        if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+            if (!previous_was_space) {
+                out.push_back(' ');
+                previous_was_space = true;
+            }
+        } else {
+            out.push_back(c);
+            previous_was_space = false;
+        }
+    }
+    return trim_copy(out);
+}
+
+std::string format_range_value(double value, bool is_float) {
+    if (!is_float) {
+        return format_integer(static_cast<long long>(std::trunc(value))).str();
+    }
+    return format_fixed<2>(value).str();
+}
+
+bool has_fractional_component(double value) {
+    return std::fabs(value - std::round(value)) > 0.000001;
+}
+
+std::string format_scalar(double value, bool as_float) {
+    return format_range_value(value, as_float || has_fractional_component(value));
+}
+
+std::optional<std::string> normalize_color_value(const std::string& input) {
+    std::string value = trim_copy(input);
+    if (value.empty()) {
+        return std::string();
+    }
+
+    if (is_digits_only(value)) {
+        return value;
+    }
+
+    if (value.size() > 2 && (value[0] == '0') && (value[1] == 'x' || value[1] == 'X')) {
+        const std::string hex_part = value.substr(2);
+        if (!is_hex_digits_only(hex_part)) {
+            return std::nullopt;
+        }
+        return std::string("0x") + lower_copy(hex_part);
+    }
+
+    if (!value.empty() && value[0] == '#') {
+        const std::string hex_part = value.substr(1);
+        if ((hex_part.size() != 6 && hex_part.size() != 8) || !is_hex_digits_only(hex_part)) {
+            return std::nullopt;
+        }
+        return std::string("0x") + lower_copy(hex_part);
+    }
+
+    if ((value.size() == 6 || value.size() == 8) && is_hex_digits_only(value)) {
+        return std::string("0x") + lower_copy(value);
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string> normalize_gradient_value(const std::string& input) {
+    std::string value = collapse_whitespace(input);
+    if (value.empty()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<std::pair<double, double>> parse_vector_value(const std::string& input) {
+    // Two numbers separated by whitespace and/or a comma, nothing else.
+    std::string_view rest(input);
+    std::optional<double> components[2];
+    for (auto& component : components) {
+        rest.remove_prefix(std::min(rest.find_first_not_of(" \t\n\r\f\v,"), rest.size()));
+        const size_t length = std::min(rest.find_first_of(" \t\n\r\f\v,"), rest.size());
+        component = parse_number(rest.substr(0, length));
+        if (!component.has_value()) {
+            return std::nullopt;
+        }
+        rest.remove_prefix(length);
+    }
+
+    if (rest.find_first_not_of(" \t\n\r\f\v,") != std::string_view::npos) {
+        return std::nullopt;
+    }
+    return std::make_pair(*components[0], *components[1]);
+}
+
+std::string format_vector_value(double x, double y, bool as_float) {
+    return format_scalar(x, as_float) + ", " + format_scalar(y, as_float);
+}
+
+std::optional<bool> ValueTraits<ValueType::Bool>::parse(std::string_view text) {
+    const std::string_view value = trim_view(text);
+    for (std::string_view spelling : {"true", "1", "yes", "on"}) {
+        if (equals_ignore_case(value, spelling)) {
+            return true;
+        }
+    }
+    for (std::string_view spelling : {"false", "0", "no", "off"}) {
+        if (equals_ignore_case(value, spelling)) {
+            return false;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<long long> ValueTraits<ValueType::Int>::parse(std::string_view text) {
+    return parse_leading_integer(text);
+}
+
+std::string ValueTraits<ValueType::Int>::format(long long value) {
+    return format_integer(value).str();
+}
+
+std::optional<double> ValueTraits<ValueType::Float>::parse(std::string_view text) {
+    return parse_number(text);
+}
+
+std::string ValueTraits<ValueType::Float>::format(double value) {
+    return format_fixed<6>(value).str();
+}
+
+bool ValueTraits<ValueType::Float>::equal(double lhs, double rhs) {
+    return std::fabs(lhs - rhs) < kNumberTolerance;
+}
+
+std::optional<std::string> ValueTraits<ValueType::String>::parse(std::string_view text) {
+    if (text == kEmptyMarker) {
+        return std::string();
+    }
+    return collapse_whitespace(std::string(text));
+}
+
+std::optional<std::string> ValueTraits<ValueType::LongString>::parse(std::string_view text) {
+    if (text == kEmptyMarker) {
+        return std::string();
+    }
+    return std::string(text);
+}
+
+std::optional<std::string> ValueTraits<ValueType::Color>::parse(std::string_view text) {
+    return normalize_color_value(std::string(text));
+}
+
+std::optional<long long> ValueTraits<ValueType::Choice>::parse(std::string_view text) {
+    return parse_leading_integer(text);
+}
+
+std::string ValueTraits<ValueType::Choice>::format(long long value) {
+    return format_integer(value).str();
+}
+
+std::optional<std::string> ValueTraits<ValueType::Gradient>::parse(std::string_view text) {
+    return normalize_gradient_value(std::string(text));
+}
+
+std::optional<Vec2> ValueTraits<ValueType::Vec2>::parse(std::string_view text) {
+    auto vector = parse_vector_value(std::string(text));
+    if (!vector.has_value()) {
+        return std::nullopt;
+    }
+    return Vec2{vector->first, vector->second};
+}
+
+std::string ValueTraits<ValueType::Vec2>::format(const Vec2& value) {
+    return format_vector_value(value.x, value.y, false);
+}
+
+bool ValueTraits<ValueType::Vec2>::equal(const Vec2& lhs, const Vec2& rhs) {
+    return std::fabs(lhs.x - rhs.x) < kNumberTolerance && std::fabs(lhs.y - rhs.y) < kNumberTolerance;
+}
+
+std::optional<std::string> normalize_value(ValueType type, std::string_view text) {
+    return dispatch_value_type(type, [text](auto tag) {
+        return ValueTraits<decltype(tag)::value>::normalize(text);
+    });
+}
+}  // namespace core
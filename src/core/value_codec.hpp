@@ -0,0 +1,170 @@
+#ifndef CORE_VALUE_CODEC_HPP
+#define CORE_VALUE_CODEC_HPP
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace core {
+// Hyprland's option types, numbered as `hyprctl descriptions` reports them.
+enum class ValueType {
+    Bool = 0,
+    Int = 1,
+    Float = 2,
+    String = 3,
+    LongString = 4,
+    Color = 5,
+    Choice = 6,
+    Gradient = 7,
+    Vec2 = 8,
+};
+
+// Unknown ids are treated as long strings, whose text is kept as is.
+constexpr ValueType value_type_from_id(int id) {
+    return (id >= 0 && id <= static_cast<int>(ValueType::Vec2)) ? static_cast<ValueType>(id)
+                                                                 : ValueType::LongString;
+}
+
+struct Vec2 {
+    double x = 0.0;
+    double y = 0.0;
+};
+
+std::string trim_copy(const std::string& value);
+std::string collapse_whitespace(const std::string& value);
+
+// Integers without a fraction, everything else with up to two decimals.
+std::string format_range_value(double value, bool is_float);
+bool has_fractional_component(double value);
+std::string format_scalar(double value, bool as_float);
+
+// Colors are kept as decimal or lowercase 0x-prefixed hex.
+std::optional<std::string> normalize_color_value(const std::string& input);
+std::optional<std::string> normalize_gradient_value(const std::string& input);
+
+// "x y" or "x, y".
+std::optional<std::pair<double, double>> parse_vector_value(const std::string& input);
+std::string format_vector_value(double x, double y, bool as_float);
+
+// Per-type codec. Every specialisation provides:
+//   Payload                      decoded representation
+//   parse(text) -> optional<Payload>
+//   format(payload) -> canonical text
+//   normalize(text) -> optional canonical text
+//   equal(lhs, rhs)
+template <ValueType T>
+struct ValueTraits;
+
+template <ValueType T, typename P>
+struct ValueTraitsBase {
+    using Payload = P;
+
+    static std::optional<std::string> normalize(std::string_view text) {
+        auto parsed = ValueTraits<T>::parse(text);
+        if (!parsed.has_value()) {
+            return std::nullopt;
+        }
+        return ValueTraits<T>::format(std::move(*parsed));
+    }
+
+    static bool equal(const P& lhs, const P& rhs) { return lhs == rhs; }
+};
+
+// Text kinds: the canonical text is the payload.
+template <ValueType T>
+struct TextTraitsBase : ValueTraitsBase<T, std::string> {
+    static std::string format(std::string value) { return value; }
+};
+
+template <>
+struct ValueTraits<ValueType::Bool> : ValueTraitsBase<ValueType::Bool, bool> {
+    static std::optional<bool> parse(std::string_view text);
+    static std::string format(bool value) { return value ? "true" : "false"; }
+};
+
+template <>
+struct ValueTraits<ValueType::Int> : ValueTraitsBase<ValueType::Int, long long> {
+    // Truncates toward zero, like typing "2.7" into an integer field.
+    static std::optional<long long> parse(std::string_view text);
+    static std::string format(long long value);
+};
+
+template <>
+struct ValueTraits<ValueType::Float> : ValueTraitsBase<ValueType::Float, double> {
+    static std::optional<double> parse(std::string_view text);
+    static std::string format(double value);
+    static bool equal(double lhs, double rhs);
+};
+
+template <>
+struct ValueTraits<ValueType::String> : TextTraitsBase<ValueType::String> {
+    // Whitespace runs collapse to one space.
+    static std::optional<std::string> parse(std::string_view text);
+};
+
+template <>
+struct ValueTraits<ValueType::LongString> : TextTraitsBase<ValueType::LongString> {
+    static std::optional<std::string> parse(std::string_view text);
+};
+
+template <>
+struct ValueTraits<ValueType::Color> : TextTraitsBase<ValueType::Color> {
+    static std::optional<std::string> parse(std::string_view text);
+};
+
+// Choices are stored as the index Hyprland expects.
+template <>
+struct ValueTraits<ValueType::Choice> : ValueTraitsBase<ValueType::Choice, long long> {
+    static std::optional<long long> parse(std::string_view text);
+    static std::string format(long long value);
+};
+
+template <>
+struct ValueTraits<ValueType::Gradient> : TextTraitsBase<ValueType::Gradient> {
+    static std::optional<std::string> parse(std::string_view text);
+};
+
+template <>
+struct ValueTraits<ValueType::Vec2> : ValueTraitsBase<ValueType::Vec2, Vec2> {
+    static std::optional<Vec2> parse(std::string_view text);
+    static std::string format(const Vec2& value);
+    static bool equal(const Vec2& lhs, const Vec2& rhs);
+};
+
+template <ValueType T>
+using ValueTypeTag = std::integral_constant<ValueType, T>;
+
+// Switches on `type` once and hands `fn` a ValueTypeTag, so everything inside
+// `fn` resolves ValueTraits at compile time.
+template <typename Fn>
+decltype(auto) dispatch_value_type(ValueType type, Fn&& fn) {
+    switch (type) {
+    case ValueType::Bool:
+        return fn(ValueTypeTag<ValueType::Bool>{});
+    case ValueType::Int:
+        return fn(ValueTypeTag<ValueType::Int>{});
+    case ValueType::Float:
+        return fn(ValueTypeTag<ValueType::Float>{});
+    case ValueType::String:
+        return fn(ValueTypeTag<ValueType::String>{});
+    case ValueType::Color:
+        return fn(ValueTypeTag<ValueType::Color>{});
+    case ValueType::Choice:
+        return fn(ValueTypeTag<ValueType::Choice>{});
+    case ValueType::Gradient:
+        return fn(ValueTypeTag<ValueType::Gradient>{});
+    case ValueType::Vec2:
+        return fn(ValueTypeTag<ValueType::Vec2>{});
+    case ValueType::LongString:
+        break;
+    }
+    return fn(ValueTypeTag<ValueType::LongString>{});
+}
+
+// Canonical text for `text` read as `type`, or nothing when it does not parse.
+std::optional<std::string> normalize_value(ValueType type, std::string_view text);
+}  // namespace core
+
+#endif
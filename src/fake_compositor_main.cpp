@@ -0,0 +1,72 @@
+#include "platform/fake_compositor.hpp"
+
+#include <csignal>
+#include <pthread.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+void print_usage(const char* argv0) {
+    std::cerr << "usage: " << argv0
+              << " --socket PATH [--replay FILE]... [--latency-ms N] [--jitter-ms N] [--strict]\n";
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    hyprland::FakeCompositor::Options options;
+    std::string socketPath;
+    std::vector<std::string> replayFiles;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--socket" && hasValue) {
+            socketPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            replayFiles.emplace_back(argv[++i]);
+        } else if (arg == "--latency-ms" && hasValue) {
+            options.latency = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (arg == "--jitter-ms" && hasValue) {
+            options.jitter = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (arg == "--strict") {
+            options.accept_unknown_keywords = false;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (socketPath.empty()) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    // Blocked before the server threads start so they inherit the mask and
+    // the signals stay pending for sigwait instead of racing a flag check.
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    hyprland::FakeCompositor compositor(options);
+    for (const auto& file : replayFiles) {
+        if (!compositor.load_replay_file(file)) {
+            std::cerr << "No entries in replay file: " << file << '\n';
+        }
+    }
+    if (!compositor.start(socketPath)) {
+        std::cerr << "Failed to listen on " << socketPath << '\n';
+        return 1;
+    }
+
+    std::cerr << "Serving on " << socketPath
+              << "; run hyprland-settings-gui with HYPRLAND_SETTINGS_SOCKET=" << socketPath << '\n';
+    int signal = 0;
+    sigwait(&stopSignals, &signal);
+
+    compositor.stop();
+    std::cerr << "Served " << compositor.requests_served() << " requests\n";
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "features/device_schema.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+struct ClassRule {
+    DeviceClass device_class;
+    // Matched against the start of the full option name.
+    const char* prefix;
+};
+
+// The global options a device block can override, per class. Where two
+// options share a short name the earlier rule wins, so mice get
+// input:natural_scroll rather than the touchpad one. Hyprland has no global
+// `enabled` for keyboards and pointers; they borrow the touch device's.
+constexpr ClassRule kRules[] = {
+    {DeviceClass::Keyboard, "input:kb_"},
+    {DeviceClass::Keyboard, "input:repeat_"},
+    {DeviceClass::Keyboard, "input:numlock_by_default"},
+    {DeviceClass::Keyboard, "input:resolve_binds_by_sym"},
+    {DeviceClass::Keyboard, "input:touchdevice:enabled"},
+    {DeviceClass::Pointer, "input:sensitivity"},
+    {DeviceClass::Pointer, "input:accel_profile"},
+    {DeviceClass::Pointer, "input:left_handed"},
+    {DeviceClass::Pointer, "input:natural_scroll"},
+    {DeviceClass::Pointer, "input:scroll_"},
+    {DeviceClass::Pointer, "input:rotation"},
+    {DeviceClass::Pointer, "input:touchpad:"},
+    {DeviceClass::Pointer, "input:touchdevice:enabled"},
+    {DeviceClass::Touch, "input:touchdevice:"},
+    {DeviceClass::Tablet, "input:tablet:"},
+};
+
+std::string short_name(const std::string& name) {
+    const size_t pos = name.rfind(':');
+    return pos == std::string::npos ? name : name.substr(pos + 1);
+}
+}  // namespace
+
+namespace features {
+const char* device_class_name(DeviceClass device_class) {
+    switch (device_class) {
+    case DeviceClass::Keyboard:
+        return "keyboard";
+    case DeviceClass::Pointer:
+        return "pointer";
+    case DeviceClass::Touch:
+        return "touch";
+    case DeviceClass::Tablet:
+        return "tablet";
+    }
+    return "";
+}
+
+DeviceSchema::DeviceSchema(const SettingsSnapshot& snapshot) {
+    const std::string inputPrefix = "input:";
+    std::vector<size_t> inputOptions;
+    for (size_t i = 0; i < snapshot.options.size(); ++i) {
+        if (snapshot.options[i].name.compare(0, inputPrefix.size(), inputPrefix) == 0) {
+            inputOptions.push_back(i);
+        }
+    }
+
+    std::array<std::unordered_map<std::string, size_t>, kDeviceClassCount> byName;
+    for (const auto& rule : kRules) {
+        const std::string prefix = rule.prefix;
+        auto& seen = byName[static_cast<size_t>(rule.device_class)];
+        for (size_t index : inputOptions) {
+            const std::string& name = snapshot.options[index].name;
+            if (name.compare(0, prefix.size(), prefix) == 0) {
+                seen.emplace(short_name(name), index);
+            }
+        }
+    }
+
+    for (size_t c = 0; c < kDeviceClassCount; ++c) {
+        auto& options = m_options[c];
+        options.reserve(byName[c].size());
+        for (const auto& entry : byName[c]) {
+            options.push_back({entry.first, entry.second});
+        }
+        std::sort(options.begin(), options.end(),
+                  [](const DeviceOption& a, const DeviceOption& b) { return a.name < b.name; });
+    }
+}
+
+const std::vector<DeviceOption>& DeviceSchema::options(DeviceClass device_class) const {
+    return m_options[static_cast<size_t>(device_class)];
+}
+
+const DeviceOption* DeviceSchema::find(DeviceClass device_class, const std::string& name) const {
+    const auto& options = this->options(device_class);
+    auto it = std::lower_bound(options.begin(), options.end(), name,
+                               [](const DeviceOption& option, const std::string& key) { return option.name < key; });
+    return it != options.end() && it->name == name ? &*it : nullptr;
+}
+}  // namespace features
@@ -0,0 +1,39 @@
+#ifndef FEATURES_DEVICE_SCHEMA_HPP
+#define FEATURES_DEVICE_SCHEMA_HPP
+
+#include "core/models.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace features {
+// An option a device block accepts, typed by the input option it overrides.
+struct DeviceOption {
+    // As written in the device block: "natural_scroll", "tap-to-click".
+    std::string name;
+    // The global option in SettingsSnapshot::options it overrides.
+    size_t option_index = 0;
+};
+
+// "keyboard", "pointer", "touch" or "tablet".
+const char* device_class_name(DeviceClass device_class);
+
+// The options each device class accepts, indexed once per snapshot from the
+// input, input:touchpad, input:touchdevice and input:tablet sections.
+class DeviceSchema {
+public:
+    DeviceSchema() = default;
+    explicit DeviceSchema(const SettingsSnapshot& snapshot);
+
+    // Sorted by name.
+    const std::vector<DeviceOption>& options(DeviceClass device_class) const;
+    const DeviceOption* find(DeviceClass device_class, const std::string& name) const;
+
+private:
+    std::array<std::vector<DeviceOption>, kDeviceClassCount> m_options;
+};
+}  // namespace features
+
+#endif
@@ -0,0 +1,106 @@
+#include "features/edit_history.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace features {
+EditHistory::EditHistory(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1)) {}
+
+void EditHistory::record(const std::string& name, const std::string& before, const std::string& after,
+                         bool keep_open) {
+    if (m_open && !m_undo.empty() && m_undo.back().size() == 1 && m_undo.back().front().name == name) {
+        Change& change = m_undo.back().front();
+        change.after = after;
+        m_open = keep_open;
+        // A drag that ends where it started leaves nothing to undo.
+        if (change.before == change.after) {
+            m_undo.pop_back();
+            m_open = false;
+        }
+        return;
+    }
+
+    if (before == after) {
+        return;
+    }
+    push({Change{name, before, after}});
+    m_open = keep_open;
+}
+
+void EditHistory::record_batch(std::vector<Change> changes) {
+    changes.erase(std::remove_if(changes.begin(), changes.end(),
+                                 [](const Change& change) { return change.before == change.after; }),
+                  changes.end());
+    if (changes.empty()) {
+        return;
+    }
+    push(std::move(changes));
+    m_open = false;
+}
+
+bool EditHistory::can_undo() const {
+    return !m_undo.empty();
+}
+
+bool EditHistory::can_redo() const {
+    return !m_redo.empty();
+}
+
+OptionAssignments EditHistory::undo() {
+    OptionAssignments assignments;
+    if (m_undo.empty()) {
+        return assignments;
+    }
+
+    Entry entry = std::move(m_undo.back());
+    m_undo.pop_back();
+    m_open = false;
+    // Reverse order, so an option changed twice in one entry ends at its
+    // first before value.
+    assignments.reserve(entry.size());
+    for (auto it = entry.rbegin(); it != entry.rend(); ++it) {
+        assignments.emplace_back(it->name, it->before);
+    }
+    m_redo.push_back(std::move(entry));
+    return assignments;
+}
+
+OptionAssignments EditHistory::redo() {
+    OptionAssignments assignments;
+    if (m_redo.empty()) {
+        return assignments;
+    }
+
+    Entry entry = std::move(m_redo.back());
+    m_redo.pop_back();
+    assignments.reserve(entry.size());
+    for (const auto& change : entry) {
+        assignments.emplace_back(change.name, change.after);
+    }
+    m_undo.push_back(std::move(entry));
+    m_open = false;
+    return assignments;
+}
+
+size_t EditHistory::undo_size() const {
+    return m_undo.size();
+}
+
+size_t EditHistory::redo_size() const {
+    return m_redo.size();
+}
+
+void EditHistory::clear() {
+    m_undo.clear();
+    m_redo.clear();
+    m_open = false;
+}
+
+void EditHistory::push(Entry entry) {
+    m_redo.clear();
+    m_undo.push_back(std::move(entry));
+    if (m_undo.size() > m_capacity) {
+        m_undo.pop_front();
+    }
+}
+}  // namespace features
@@ -0,0 +1,59 @@
+#ifndef FEATURES_EDIT_HISTORY_HPP
+#define FEATURES_EDIT_HISTORY_HPP
+
+#include "core/models.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace features {
+// Undo/redo stacks of option deltas. Only the values on either side of a
+// change are kept, and the oldest entries are dropped past the capacity, so
+// a long session costs at most capacity entries.
+class EditHistory {
+public:
+    struct Change {
+        std::string name;
+        std::string before;
+        std::string after;
+    };
+
+    static constexpr size_t kDefaultCapacity = 200;
+
+    explicit EditHistory(size_t capacity = kDefaultCapacity);
+
+    // Records one change. While an entry is open, further changes to the same
+    // option merge into it, keeping the first before value; this is how the
+    // runtime steps of a slider drag become one entry. A change with
+    // keep_open false closes the entry.
+    void record(const std::string& name, const std::string& before, const std::string& after,
+                bool keep_open = false);
+    // Records several changes made together as one closed entry.
+    void record_batch(std::vector<Change> changes);
+
+    bool can_undo() const;
+    bool can_redo() const;
+    // Assignments that revert (or repeat) the most recent entry, to be
+    // applied as one batch. Empty when there is nothing to do.
+    OptionAssignments undo();
+    OptionAssignments redo();
+
+    size_t undo_size() const;
+    size_t redo_size() const;
+    void clear();
+
+private:
+    using Entry = std::vector<Change>;
+
+    void push(Entry entry);
+
+    size_t m_capacity;
+    std::deque<Entry> m_undo;
+    std::vector<Entry> m_redo;
+    bool m_open = false;
+};
+}  // namespace features
+
+#endif
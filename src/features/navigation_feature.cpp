@@ -4,8 +4,7 @@ namespace features {
 void handle_section_selected(
     bool& selecting_programmatically,
     bool& scrolling_programmatically,
-    Gtk::TreeView& tree_view,
-    const Gtk::TreeModelColumn<Glib::ustring>& full_path_column,
+    const std::string& selected_path,
     const std::map<std::string, Gtk::Widget*>& section_widgets,
     Gtk::Box& content_vbox,
     Gtk::ScrolledWindow& content_scroll) {
@@ -13,13 +12,7 @@ void handle_section_selected(
         return;
     }
 
-    auto iter = tree_view.get_selection()->get_selected();
-    if (!iter) {
-        return;
-    }
-
-    Glib::ustring fullPath = (*iter)[full_path_column];
-    auto sectionIt = section_widgets.find(fullPath.raw());
+    auto sectionIt = section_widgets.find(selected_path);
     if (sectionIt == section_widgets.end()) {
         return;
     }
@@ -38,9 +31,7 @@ void handle_scroll_changed(
     bool& scrolling_programmatically,
     bool& selecting_programmatically,
     const std::vector<std::pair<std::string, Gtk::Widget*>>& ordered_sections,
-    const std::map<std::string, Gtk::TreeModel::iterator>& section_iters,
-    Gtk::TreeView& tree_view,
-    const Glib::RefPtr<Gtk::TreeStore>& section_tree_store,
+    const std::function<void(const std::string&)>& select_section,
     Gtk::Box& content_vbox,
     Gtk::ScrolledWindow& content_scroll) {
     if (scrolling_programmatically || ordered_sections.empty()) {
@@ -67,14 +58,8 @@ void handle_scroll_changed(
         return;
     }
 
-    auto iterIt = section_iters.find(currentPath);
-    if (iterIt == section_iters.end()) {
-        return;
-    }
-
     selecting_programmatically = true;
-    tree_view.get_selection()->select(iterIt->second);
-    tree_view.scroll_to_row(section_tree_store->get_path(iterIt->second));
+    select_section(currentPath);
     selecting_programmatically = false;
 }
 }  // namespace features
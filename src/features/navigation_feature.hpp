@@ -3,6 +3,7 @@
 
 #include <gtkmm.h>
 
+#include <functional>
 #include <map>
 #include <string>
 #include <utility>
@@ -12,8 +13,7 @@ namespace features {
 void handle_section_selected(
     bool& selecting_programmatically,
     bool& scrolling_programmatically,
-    Gtk::TreeView& tree_view,
-    const Gtk::TreeModelColumn<Glib::ustring>& full_path_column,
+    const std::string& selected_path,
     const std::map<std::string, Gtk::Widget*>& section_widgets,
     Gtk::Box& content_vbox,
     Gtk::ScrolledWindow& content_scroll);
@@ -22,9 +22,7 @@ void handle_scroll_changed(
     bool& scrolling_programmatically,
     bool& selecting_programmatically,
     const std::vector<std::pair<std::string, Gtk::Widget*>>& ordered_sections,
-    const std::map<std::string, Gtk::TreeModel::iterator>& section_iters,
-    Gtk::TreeView& tree_view,
-    const Glib::RefPtr<Gtk::TreeStore>& section_tree_store,
+    const std::function<void(const std::string&)>& select_section,
     Gtk::Box& content_vbox,
     Gtk::ScrolledWindow& content_scroll);
 }
@@ -0,0 +1,100 @@
+#include "features/option_facets.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace features {
+void OptionFacets::rebuild(const SettingsSnapshot& snapshot) {
+    m_size = snapshot.options.size();
+    m_modified = core::OptionBitset(m_size);
+    m_nonDefault = core::OptionBitset(m_size);
+    m_types.assign(kValueTypeCount, core::OptionBitset(m_size));
+    m_defaults.assign(m_size, std::nullopt);
+    m_sections.clear();
+    m_sectionNames.clear();
+
+    for (size_t i = 0; i < m_size; ++i) {
+        const auto& option = snapshot.options[i];
+        m_modified.set(i, option.set_by_user);
+        // Choice options report their labels where other types report the
+        // default, so they have no comparable default. Neither does a default
+        // that does not parse, such as the empty one vec2 options get.
+        if (core::value_type_from_id(option.value_type) != core::ValueType::Choice) {
+            core::OptionValue defaultValue = core::OptionValue::decode(option.value_type, option.default_value);
+            if (defaultValue.is_valid()) {
+                m_defaults[i] = std::move(defaultValue);
+                set_value(i, core::OptionValue::decode(option.value_type, option.value));
+            }
+        }
+        if (option.value_type >= 0 && option.value_type < kValueTypeCount) {
+            m_types[static_cast<size_t>(option.value_type)].set(i);
+        }
+
+        const std::string section = top_level_section(option.section_path);
+        auto it = m_sections.find(section);
+        if (it == m_sections.end()) {
+            it = m_sections.emplace(section, core::OptionBitset(m_size)).first;
+            m_sectionNames.push_back(section);
+        }
+        it->second.set(i);
+    }
+    std::sort(m_sectionNames.begin(), m_sectionNames.end());
+}
+
+void OptionFacets::set_modified(size_t option, bool modified) {
+    m_modified.set(option, modified);
+}
+
+void OptionFacets::set_value(size_t option, const core::OptionValue& value) {
+    if (option < m_defaults.size() && m_defaults[option].has_value()) {
+        m_nonDefault.set(option, value != *m_defaults[option]);
+    }
+}
+
+const std::vector<std::string>& OptionFacets::sections() const {
+    return m_sectionNames;
+}
+
+const core::OptionBitset& OptionFacets::non_default() const {
+    return m_nonDefault;
+}
+
+const core::OptionBitset& OptionFacets::modified() const {
+    return m_modified;
+}
+
+const std::optional<core::OptionValue>& OptionFacets::default_value(size_t option) const {
+    static const std::optional<core::OptionValue> kNone;
+    return option < m_defaults.size() ? m_defaults[option] : kNone;
+}
+
+core::OptionBitset OptionFacets::combine(const FacetSelection& selection,
+                                         const core::OptionBitset* search) const {
+    const core::OptionBitset* type = nullptr;
+    if (selection.value_type >= 0 && selection.value_type < static_cast<int>(m_types.size())) {
+        type = &m_types[static_cast<size_t>(selection.value_type)];
+    }
+
+    static const core::OptionBitset kEmpty;
+    const core::OptionBitset* section = nullptr;
+    if (!selection.section.empty()) {
+        auto it = m_sections.find(selection.section);
+        section = it != m_sections.end() ? &it->second : &kEmpty;
+    }
+
+    return core::OptionBitset::intersection(m_size, {
+        selection.modified_only ? &m_modified : nullptr,
+        selection.non_default_only ? &m_nonDefault : nullptr,
+        type,
+        section,
+        search,
+    });
+}
+
+std::string OptionFacets::top_level_section(const std::string& section_path) {
+    if (section_path.empty()) {
+        return "(root)";
+    }
+    return section_path.substr(0, section_path.find(':'));
+}
+}  // namespace features
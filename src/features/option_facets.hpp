@@ -0,0 +1,59 @@
+#ifndef FEATURES_OPTION_FACETS_HPP
+#define FEATURES_OPTION_FACETS_HPP
+
+#include "core/models.hpp"
+#include "core/option_bitset.hpp"
+#include "core/option_value.hpp"
+#include "core/value_codec.hpp"
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace features {
+struct FacetSelection {
+    bool modified_only = false;
+    bool non_default_only = false;
+    int value_type = -1;
+    // Top-level section, or empty for all of them.
+    std::string section;
+};
+
+// Per-facet bitsets over snapshot option indices. Any combination of facets
+// (and the search matches) reduces to one word-wise AND.
+class OptionFacets {
+public:
+    static constexpr int kValueTypeCount = static_cast<int>(core::ValueType::Vec2) + 1;
+
+    void rebuild(const SettingsSnapshot& snapshot);
+
+    void set_modified(size_t option, bool modified);
+    // Re-evaluates the non-default facet for a new value of the option.
+    void set_value(size_t option, const core::OptionValue& value);
+
+    const std::vector<std::string>& sections() const;
+    const core::OptionBitset& non_default() const;
+    const core::OptionBitset& modified() const;
+    // Decoded default of the option; empty for choice options and defaults
+    // that do not parse.
+    const std::optional<core::OptionValue>& default_value(size_t option) const;
+
+    core::OptionBitset combine(const FacetSelection& selection, const core::OptionBitset* search) const;
+
+    static std::string top_level_section(const std::string& section_path);
+
+private:
+    size_t m_size = 0;
+    core::OptionBitset m_modified;
+    core::OptionBitset m_nonDefault;
+    std::vector<core::OptionBitset> m_types;
+    // Decoded defaults; choice options and unparsable defaults have none.
+    std::vector<std::optional<core::OptionValue>> m_defaults;
+    std::map<std::string, core::OptionBitset> m_sections;
+    std::vector<std::string> m_sectionNames;
+};
+}  // namespace features
+
+#endif
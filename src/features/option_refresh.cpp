@@ -0,0 +1,54 @@
+#include "features/option_refresh.hpp"
+
+#include <chrono>
+#include <system_error>
+#include <utility>
+
+namespace features {
+OptionRefresh::OptionRefresh(const SettingsController& controller) : m_controller(controller) {}
+
+std::filesystem::file_time_type OptionRefresh::config_mtime() const {
+    std::error_code error;
+    const auto mtime = std::filesystem::last_write_time(m_controller.config_path(), error);
+    return error ? std::filesystem::file_time_type{} : mtime;
+}
+
+void OptionRefresh::launch(std::vector<std::string> names) {
+    m_startMtime = config_mtime();
+    const SettingsController* controller = &m_controller;
+    m_pending = std::async(std::launch::async, [controller, names = std::move(names)]() {
+        return controller->refresh_options(names);
+    });
+}
+
+void OptionRefresh::start(std::vector<std::string> names) {
+    if (names.empty()) {
+        return;
+    }
+    if (m_pending.valid()) {
+        m_queued.insert(m_queued.end(), names.begin(), names.end());
+        return;
+    }
+    launch(std::move(names));
+}
+
+bool OptionRefresh::running() const {
+    return m_pending.valid();
+}
+
+std::optional<std::vector<OptionState>> OptionRefresh::poll() {
+    if (!m_pending.valid() || m_pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return std::nullopt;
+    }
+    std::vector<OptionState> states = m_pending.get();
+    const bool stale = config_mtime() != m_startMtime;
+    if (!m_queued.empty()) {
+        launch(std::move(m_queued));
+        m_queued.clear();
+    }
+    if (stale) {
+        return std::nullopt;
+    }
+    return states;
+}
+}  // namespace features
@@ -0,0 +1,39 @@
+#ifndef FEATURES_OPTION_REFRESH_HPP
+#define FEATURES_OPTION_REFRESH_HPP
+
+#include "core/models.hpp"
+#include "features/settings_controller.hpp"
+
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace features {
+// Re-reads options with a getoption batch off the UI thread.
+class OptionRefresh {
+public:
+    explicit OptionRefresh(const SettingsController& controller);
+
+    // Starts a background batch for names, or queues them behind the one in
+    // flight.
+    void start(std::vector<std::string> names);
+    bool running() const;
+    // The fetched states once a batch is done, starting the queued one if
+    // any. Results are dropped when the config was written while they were
+    // being read, since they may predate that write.
+    std::optional<std::vector<OptionState>> poll();
+
+private:
+    std::filesystem::file_time_type config_mtime() const;
+    void launch(std::vector<std::string> names);
+
+    const SettingsController& m_controller;
+    std::future<std::vector<OptionState>> m_pending;
+    std::filesystem::file_time_type m_startMtime{};
+    std::vector<std::string> m_queued;
+};
+}  // namespace features
+
+#endif
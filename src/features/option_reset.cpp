@@ -0,0 +1,35 @@
+#include "features/option_reset.hpp"
+
+namespace features {
+OptionAssignments reset_changes(const SettingsSnapshot& snapshot,
+                                const OptionFacets& facets,
+                                const core::OptionBitset* scope) {
+    const size_t size = snapshot.options.size();
+    core::OptionBitset candidates = facets.non_default();
+    candidates |= facets.modified();
+    if (scope) {
+        candidates &= *scope;
+    }
+
+    OptionAssignments changes;
+    candidates.for_each([&](size_t index) {
+        const auto& defaultValue = facets.default_value(index);
+        if (index < size && defaultValue && defaultValue->is_valid()) {
+            changes.emplace_back(snapshot.options[index].name, defaultValue->str());
+        }
+    });
+    return changes;
+}
+
+core::OptionBitset section_options(const SettingsSnapshot& snapshot, const std::string& section_path) {
+    core::OptionBitset options(snapshot.options.size());
+    const std::string nested = section_path + ":";
+    for (size_t i = 0; i < snapshot.options.size(); ++i) {
+        const std::string& path = snapshot.options[i].section_path;
+        if (path == section_path || path.compare(0, nested.size(), nested) == 0) {
+            options.set(i);
+        }
+    }
+    return options;
+}
+}  // namespace features
@@ -0,0 +1,23 @@
+#ifndef FEATURES_OPTION_RESET_HPP
+#define FEATURES_OPTION_RESET_HPP
+
+#include "core/models.hpp"
+#include "core/option_bitset.hpp"
+#include "features/option_facets.hpp"
+
+#include <string>
+
+namespace features {
+// Options in scope (every option when scope is null) that differ from their
+// default or are set in the config, paired with the default. Only the
+// non-default and modified bits are visited. Choice options and options
+// whose default did not parse have no known default and are left alone.
+OptionAssignments reset_changes(const SettingsSnapshot& snapshot,
+                                const OptionFacets& facets,
+                                const core::OptionBitset* scope);
+
+// Options of the section and of every section nested in it.
+core::OptionBitset section_options(const SettingsSnapshot& snapshot, const std::string& section_path);
+}  // namespace features
+
+#endif
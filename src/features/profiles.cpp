@@ -0,0 +1,172 @@
+#include "features/profiles.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+constexpr const char* kProfileExtension = ".conf";
+
+std::filesystem::path default_profile_directory() {
+    std::filesystem::path base;
+    if (const char* config = std::getenv("XDG_CONFIG_HOME"); config && *config) {
+        base = config;
+    } else if (const char* home = std::getenv("HOME"); home && *home) {
+        base = std::filesystem::path(home) / ".config";
+    } else {
+        base = ".";
+    }
+    return base / "hyprland-settings" / "profiles";
+}
+
+std::string trim(const std::string& text) {
+    const size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    const size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+core::OptionValue current_value(const ConfigOptionData& option,
+                                const std::unordered_map<std::string, core::OptionValue>& values) {
+    auto it = values.find(option.name);
+    return it != values.end() ? it->second : core::OptionValue::decode(option.value_type, option.value);
+}
+}  // namespace
+
+namespace features {
+Profile capture_profile(const std::string& name,
+                        const SettingsSnapshot& snapshot,
+                        const std::unordered_map<std::string, core::OptionValue>& values,
+                        const OptionFacets& facets) {
+    Profile profile;
+    profile.name = name;
+    for (size_t i = 0; i < snapshot.options.size(); ++i) {
+        const auto& option = snapshot.options[i];
+        const core::OptionValue value = current_value(option, values);
+        const auto& defaultValue = facets.default_value(i);
+        if (!defaultValue || value != *defaultValue) {
+            profile.options.emplace_back(option.name, value.str());
+        }
+    }
+    return profile;
+}
+
+ProfileChanges profile_changes(const Profile& profile,
+                               const SettingsSnapshot& snapshot,
+                               const std::unordered_map<std::string, size_t>& indices,
+                               const std::unordered_map<std::string, core::OptionValue>& values,
+                               const OptionFacets& facets) {
+    ProfileChanges changes;
+    std::unordered_set<size_t> listed;
+    listed.reserve(profile.options.size());
+
+    for (const auto& entry : profile.options) {
+        auto index = indices.find(entry.first);
+        if (index == indices.end() || !listed.insert(index->second).second) {
+            continue;
+        }
+        const auto& option = snapshot.options[index->second];
+        const core::OptionValue current = current_value(option, values);
+        const core::OptionValue wanted = core::OptionValue::decode(current.type(), entry.second);
+        if (wanted != current) {
+            changes.values.emplace_back(option.name, wanted.str());
+        }
+    }
+
+    // Whatever is off its default now but not in the profile goes back.
+    facets.non_default().for_each([&](size_t index) {
+        if (listed.count(index) > 0) {
+            return;
+        }
+        const auto& defaultValue = facets.default_value(index);
+        if (defaultValue && defaultValue->is_valid()) {
+            changes.defaults.emplace_back(snapshot.options[index].name, defaultValue->str());
+        }
+    });
+    return changes;
+}
+
+ProfileStore::ProfileStore() : m_directory(default_profile_directory()) {}
+
+ProfileStore::ProfileStore(std::filesystem::path directory) : m_directory(std::move(directory)) {}
+
+std::vector<std::string> ProfileStore::names() const {
+    std::vector<std::string> names;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, ec)) {
+        const auto& path = entry.path();
+        if (entry.is_regular_file(ec) && path.extension() == kProfileExtension) {
+            names.push_back(path.stem().string());
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::optional<Profile> ProfileStore::load(const std::string& name) const {
+    if (!valid_name(name)) {
+        return std::nullopt;
+    }
+    std::ifstream in(path_for(name));
+    if (!in.is_open()) {
+        return std::nullopt;
+    }
+
+    Profile profile;
+    profile.name = name;
+    std::string line;
+    while (std::getline(in, line)) {
+        const std::string content = trim(line);
+        const size_t equals = content.find('=');
+        if (content.empty() || content[0] == '#' || equals == std::string::npos) {
+            continue;
+        }
+        profile.options.emplace_back(trim(content.substr(0, equals)), trim(content.substr(equals + 1)));
+    }
+    return profile;
+}
+
+bool ProfileStore::save(const Profile& profile) const {
+    if (!valid_name(profile.name)) {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+
+    const auto path = path_for(profile.name);
+    auto temp = path;
+    temp += ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out << "# hyprland-settings profile \"" << profile.name << "\"; unlisted options use their defaults\n";
+        for (const auto& option : profile.options) {
+            out << option.first << " = " << option.second << '\n';
+        }
+        if (!out.flush()) {
+            return false;
+        }
+    }
+    std::filesystem::rename(temp, path, ec);
+    return !ec;
+}
+
+bool ProfileStore::remove(const std::string& name) const {
+    std::error_code ec;
+    return valid_name(name) && std::filesystem::remove(path_for(name), ec);
+}
+
+bool ProfileStore::valid_name(const std::string& name) {
+    return !name.empty() && name[0] != '.' && name.find('/') == std::string::npos;
+}
+
+std::filesystem::path ProfileStore::path_for(const std::string& name) const {
+    return m_directory / (name + kProfileExtension);
+}
+}  // namespace features
@@ -0,0 +1,77 @@
+#ifndef FEATURES_PROFILES_HPP
+#define FEATURES_PROFILES_HPP
+
+#include "core/models.hpp"
+#include "core/option_value.hpp"
+#include "features/option_facets.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace features {
+// A named option set, stored as its difference from the defaults: options
+// that are not listed are at their default.
+struct Profile {
+    std::string name;
+    OptionAssignments options;
+};
+
+// The current values that differ from their default, plus every choice
+// option, whose default Hyprland does not report.
+Profile capture_profile(const std::string& name,
+                        const SettingsSnapshot& snapshot,
+                        const std::unordered_map<std::string, core::OptionValue>& values,
+                        const OptionFacets& facets);
+
+// What has to be sent to go from the current values to the profile.
+struct ProfileChanges {
+    // Profile values that differ from the current ones.
+    OptionAssignments values;
+    // Options the profile leaves out that are off their default now, paired
+    // with the default. These go back to the default by dropping their
+    // config assignment rather than writing the default out.
+    OptionAssignments defaults;
+
+    bool empty() const { return values.empty() && defaults.empty(); }
+    size_t size() const { return values.size() + defaults.size(); }
+};
+
+// Only the profile's options and the currently non-default ones are visited,
+// so the cost follows how much the two differ rather than the size of the
+// schema. Options the schema does not know, and options without a usable
+// default, are skipped.
+ProfileChanges profile_changes(const Profile& profile,
+                                  const SettingsSnapshot& snapshot,
+                                  const std::unordered_map<std::string, size_t>& indices,
+                                  const std::unordered_map<std::string, core::OptionValue>& values,
+                                  const OptionFacets& facets);
+
+// One "name = value" file per profile under
+// $XDG_CONFIG_HOME/hyprland-settings/profiles, the same format
+// hyprland-settings-cli apply-file reads.
+class ProfileStore {
+public:
+    ProfileStore();
+    explicit ProfileStore(std::filesystem::path directory);
+
+    // Sorted.
+    std::vector<std::string> names() const;
+    std::optional<Profile> load(const std::string& name) const;
+    bool save(const Profile& profile) const;
+    bool remove(const std::string& name) const;
+
+    // Non-empty, no path separators, not hidden.
+    static bool valid_name(const std::string& name);
+
+private:
+    std::filesystem::path path_for(const std::string& name) const;
+
+    std::filesystem::path m_directory;
+};
+}  // namespace features
+
+#endif
@@ -17,6 +17,34 @@ bool SettingsController::apply_runtime_option(const std::string& name, const std
     return m_backend.apply_runtime_option(name, value);
 }
 
+bool SettingsController::apply_persistent_options(const OptionAssignments& options,
+                                                  std::vector<std::string>* failed) const {
+    return m_backend.apply_persistent_options(options, failed);
+}
+
+bool SettingsController::apply_runtime_options(const OptionAssignments& options,
+                                               std::vector<std::string>* failed) const {
+    return m_backend.apply_runtime_options(options, failed);
+}
+
+bool SettingsController::reset_options(const OptionAssignments& defaults,
+                                       std::vector<std::string>* failed) const {
+    return m_backend.reset_options(defaults, failed);
+}
+
+bool SettingsController::apply_changes(const OptionAssignments& values, const OptionAssignments& defaults,
+                                       std::vector<std::string>* failed) const {
+    return m_backend.apply_changes(values, defaults, failed);
+}
+
+std::vector<OptionState> SettingsController::refresh_options(const std::vector<std::string>& names) const {
+    return m_backend.refresh_options(names);
+}
+
+const std::string& SettingsController::config_path() const {
+    return m_backend.config_path();
+}
+
 bool SettingsController::add_keyword(const std::string& type, const std::string& value) const {
     return m_backend.add_keyword(type, value);
 }
@@ -5,6 +5,7 @@
 #include "platform/hyprland_backend.hpp"
 
 #include <string>
+#include <vector>
 
 class SettingsController {
 public:
@@ -13,6 +14,16 @@ public:
     SettingsSnapshot load_snapshot() const;
     bool apply_persistent_option(const std::string& name, const std::string& value) const;
     bool apply_runtime_option(const std::string& name, const std::string& value) const;
+    bool apply_persistent_options(const OptionAssignments& options,
+                                  std::vector<std::string>* failed = nullptr) const;
+    bool apply_runtime_options(const OptionAssignments& options,
+                               std::vector<std::string>* failed = nullptr) const;
+    bool reset_options(const OptionAssignments& defaults,
+                       std::vector<std::string>* failed = nullptr) const;
+    bool apply_changes(const OptionAssignments& values, const OptionAssignments& defaults,
+                       std::vector<std::string>* failed = nullptr) const;
+    std::vector<OptionState> refresh_options(const std::vector<std::string>& names) const;
+    const std::string& config_path() const;
     bool add_keyword(const std::string& type, const std::string& value) const;
     bool add_device_config(const std::string& device_name, const std::string& option,
                            const std::string& value) const;
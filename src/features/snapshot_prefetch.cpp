@@ -0,0 +1,163 @@
+#include "features/snapshot_prefetch.hpp"
+
+#include "core/trace.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+namespace {
+constexpr const char* kDescriptionIndexPrefix = "descriptions-";
+constexpr const char* kDescriptionIndexExtension = ".idx";
+
+std::filesystem::path description_index_cache_path(uint64_t fingerprint) {
+    std::filesystem::path base;
+    if (const char* cache = std::getenv("XDG_CACHE_HOME"); cache && *cache) {
+        base = cache;
+    } else if (const char* home = std::getenv("HOME"); home && *home) {
+        base = std::filesystem::path(home) / ".cache";
+    } else {
+        return {};
+    }
+
+    char name[48];
+    std::snprintf(name, sizeof(name), "%s%016llx%s", kDescriptionIndexPrefix,
+                  static_cast<unsigned long long>(fingerprint), kDescriptionIndexExtension);
+    return base / "hyprland-settings" / name;
+}
+
+// Indexes for other Hyprland versions' schemas are never read again.
+void remove_stale_description_indexes(const std::filesystem::path& current) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(current.parent_path(), ec)) {
+        const auto& path = entry.path();
+        const std::string name = path.filename().string();
+        if (path != current && name.rfind(kDescriptionIndexPrefix, 0) == 0 &&
+            path.extension() == kDescriptionIndexExtension) {
+            std::filesystem::remove(path, ec);
+        }
+    }
+}
+
+// Loads the description index for this exact schema from the cache, or builds
+// it and stores it there for the next start. A cache that cannot be read is
+// rebuilt rather than failing the load.
+core::DescriptionIndex load_or_build_description_index(const std::vector<std::string>& descriptions) {
+    const auto path = description_index_cache_path(core::DescriptionIndex::fingerprint(descriptions));
+
+    core::DescriptionIndex index;
+    if (!path.empty()) {
+        try {
+            std::ifstream in(path, std::ios::binary);
+            if (in.is_open() && index.load(in) && index.option_count() == descriptions.size()) {
+                return index;
+            }
+        } catch (const std::exception&) {
+        }
+    }
+
+    index = core::DescriptionIndex(descriptions);
+    if (path.empty()) {
+        return index;
+    }
+
+    // Written beside the final name and renamed over it, so a reader never
+    // sees half a file.
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    auto temp = path;
+    temp += ".tmp";
+    bool written = false;
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (out.is_open()) {
+            index.save(out);
+            written = static_cast<bool>(out.flush());
+        }
+    }
+    if (written) {
+        std::filesystem::rename(temp, path, ec);
+    }
+    if (!written || ec) {
+        std::filesystem::remove(temp, ec);
+        return index;
+    }
+    remove_stale_description_indexes(path);
+    return index;
+}
+}
+
+namespace features {
+PreparedSnapshot prepare_snapshot(SettingsSnapshot snapshot) {
+    HYPRLAND_TRACE_SPAN("prefetch.prepare");
+    PreparedSnapshot prepared;
+    prepared.snapshot = std::move(snapshot);
+    const SettingsSnapshot& data = prepared.snapshot;
+    core::SectionTree& tree = prepared.sections;
+
+    auto& variablesNode = tree.add_child(tree.root(), "Variables", "__variables__");
+    auto& keywordsNode = tree.add_child(tree.root(), "Keywords", "__keywords_parent__");
+    tree.add_child(keywordsNode, "Executing", "__executing__");
+    tree.add_child(keywordsNode, "Per-device Input Configs", "__device_configs__");
+    tree.add_child(keywordsNode, "Environment Variables", "__env_vars__");
+
+    for (const auto& sectionPath : data.sections) {
+        if (sectionPath.empty()) continue;
+        tree.insert_path(variablesNode, sectionPath);
+    }
+
+    if (data.has_root_options && !tree.find("")) {
+        tree.add_child(variablesNode, "(root)", "");
+    }
+
+    for (size_t i = 0; i < data.options.size(); ++i) {
+        const auto& option = data.options[i];
+        tree.add_option(option.section_path);
+        prepared.option_indices.emplace(option.name, i);
+
+        if (option.section_path.empty() ? data.has_root_options
+                                        : data.sections.count(option.section_path) > 0) {
+            prepared.section_option_indices[option.section_path].push_back(i);
+        }
+    }
+    prepared.device_schema = DeviceSchema(data);
+
+    std::vector<std::string> names;
+    std::vector<std::string> descriptions;
+    names.reserve(data.options.size());
+    descriptions.reserve(data.options.size());
+    for (const auto& option : data.options) {
+        names.push_back(option.name);
+        descriptions.push_back(option.description);
+    }
+    prepared.search_index = core::OptionSearchIndex(names);
+    prepared.description_index = load_or_build_description_index(descriptions);
+
+    return prepared;
+}
+
+SnapshotPrefetch::SnapshotPrefetch(const SettingsController& controller)
+    : m_controller(controller) {}
+
+void SnapshotPrefetch::start() {
+    if (m_pending.valid()) {
+        return;
+    }
+
+    const SettingsController* controller = &m_controller;
+    m_pending = std::async(std::launch::async, [controller]() {
+        return prepare_snapshot(controller->load_snapshot());
+    });
+}
+
+PreparedSnapshot SnapshotPrefetch::take() {
+    HYPRLAND_TRACE_SPAN("prefetch.take");
+    if (m_pending.valid()) {
+        return m_pending.get();
+    }
+    return prepare_snapshot(m_controller.load_snapshot());
+}
+}  // namespace features
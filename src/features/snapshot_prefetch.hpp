@@ -0,0 +1,49 @@
+#ifndef FEATURES_SNAPSHOT_PREFETCH_HPP
+#define FEATURES_SNAPSHOT_PREFETCH_HPP
+
+#include "core/description_index.hpp"
+#include "core/models.hpp"
+#include "core/option_search_index.hpp"
+#include "core/section_tree.hpp"
+#include "features/device_schema.hpp"
+#include "features/settings_controller.hpp"
+
+#include <cstddef>
+#include <future>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace features {
+// Everything load_data needs that does not touch GTK, so it can be built off
+// the main thread.
+struct PreparedSnapshot {
+    SettingsSnapshot snapshot;
+    core::SectionTree sections;
+    std::map<std::string, std::vector<size_t>> section_option_indices;
+    std::unordered_map<std::string, size_t> option_indices;
+    DeviceSchema device_schema;
+    core::OptionSearchIndex search_index;
+    core::DescriptionIndex description_index;
+};
+
+PreparedSnapshot prepare_snapshot(SettingsSnapshot snapshot);
+
+class SnapshotPrefetch {
+public:
+    explicit SnapshotPrefetch(const SettingsController& controller);
+
+    // Starts a background fetch unless one is already in flight.
+    void start();
+    // Returns the prefetched snapshot, waiting for it if it is still loading,
+    // or loads one on the calling thread when nothing was started.
+    PreparedSnapshot take();
+
+private:
+    const SettingsController& m_controller;
+    std::future<PreparedSnapshot> m_pending;
+};
+}  // namespace features
+
+#endif
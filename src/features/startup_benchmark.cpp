@@ -0,0 +1,60 @@
+#include "features/startup_benchmark.hpp"
+
+#include "core/metrics.hpp"
+
+#include <cstdio>
+
+namespace {
+double to_ms(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::string format_ms(double ms) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", ms);
+    return text;
+}
+}  // namespace
+
+namespace features {
+StartupBenchmark::StartupBenchmark() : m_origin(Clock::now()) {}
+
+void StartupBenchmark::mark(const std::string& phase) {
+    m_marks.emplace_back(phase, Clock::now());
+}
+
+void StartupBenchmark::set_option_count(size_t count) {
+    m_optionCount = count;
+}
+
+std::string StartupBenchmark::to_json() const {
+    const Clock::time_point end = m_marks.empty() ? m_origin : m_marks.back().second;
+
+    std::string json = "{\n  \"total_ms\": " + format_ms(to_ms(end - m_origin)) + ",\n  \"phases\": [";
+    Clock::time_point previous = m_origin;
+    for (size_t i = 0; i < m_marks.size(); ++i) {
+        const auto& mark = m_marks[i];
+        json += i == 0 ? "\n" : ",\n";
+        json += "    {\"name\": \"" + mark.first + "\", \"at_ms\": " + format_ms(to_ms(mark.second - m_origin)) +
+                ", \"delta_ms\": " + format_ms(to_ms(mark.second - previous)) + "}";
+        previous = mark.second;
+    }
+    json += "\n  ],\n  \"backend\": {";
+
+    // The snapshot is fetched on a worker thread, so its requests overlap the
+    // phases above rather than being one of them.
+    for (size_t i = 0; i < core::metrics::kOperationCount; ++i) {
+        const auto operation = static_cast<core::metrics::Operation>(i);
+        const core::LatencyHistogram& histogram = core::metrics::latency(operation);
+        std::string name = core::metrics::operation_name(operation);
+        for (char& c : name) {
+            c = c == ' ' ? '_' : c;
+        }
+        json += i == 0 ? "\n" : ",\n";
+        json += "    \"" + name + "\": {\"count\": " + std::to_string(histogram.count()) +
+                ", \"max_ms\": " + format_ms(static_cast<double>(histogram.max()) / 1e6) + "}";
+    }
+    json += "\n  },\n  \"options\": " + std::to_string(m_optionCount) + "\n}\n";
+    return json;
+}
+}  // namespace features
@@ -0,0 +1,33 @@
+#ifndef FEATURES_STARTUP_BENCHMARK_HPP
+#define FEATURES_STARTUP_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace features {
+// Timestamps from main() to the first painted frame of the settings page,
+// collected for --benchmark-startup. Only touched from the main thread.
+class StartupBenchmark {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    StartupBenchmark();
+
+    void mark(const std::string& phase);
+    void set_option_count(size_t count);
+
+    // {"total_ms": ..., "phases": [{"name", "at_ms", "delta_ms"}...],
+    //  "backend": {...}, "options": N}
+    std::string to_json() const;
+
+private:
+    Clock::time_point m_origin;
+    std::vector<std::pair<std::string, Clock::time_point>> m_marks;
+    size_t m_optionCount = 0;
+};
+}  // namespace features
+
+#endif
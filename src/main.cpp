@@ -1,9 +1,45 @@
 #include <gtkmm.h>
 
 #include "config_window.hpp"
+#include "core/metrics.hpp"
+#include "core/trace.hpp"
+#include "features/startup_benchmark.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
 
 int main(int argc, char* argv[])
 {
-    auto app = Gtk::Application::create("org.hyprland.settings");
-    return app->make_window_and_run<ConfigWindow>(argc, argv);
+    // Constructed first so the benchmark's origin is process start, near enough.
+    features::StartupBenchmark startupBenchmark;
+
+    // Our own flags are removed before GTK sees the command line, since it
+    // rejects options it does not know.
+    bool dumpMetrics = false;
+    bool benchmarkStartup = false;
+    std::vector<char*> args;
+    for (int i = 0; i < argc; ++i) {
+        if (i > 0 && std::strcmp(argv[i], "--metrics") == 0) {
+            dumpMetrics = true;
+        } else if (i > 0 && std::strcmp(argv[i], "--benchmark-startup") == 0) {
+            benchmarkStartup = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    args.push_back(nullptr);
+
+    core::trace::start_from_env();
+    // A benchmark run must not hand off to an instance that is already open.
+    auto app = Gtk::Application::create("org.hyprland.settings",
+                                        benchmarkStartup ? Gio::Application::Flags::NON_UNIQUE
+                                                         : Gio::Application::Flags::NONE);
+    const int status = app->make_window_and_run<ConfigWindow>(static_cast<int>(args.size()) - 1, args.data(),
+                                                              benchmarkStartup ? &startupBenchmark : nullptr);
+    core::trace::finish();
+    if (dumpMetrics) {
+        std::cout << core::metrics::format_report();
+    }
+    return status;
 }
@@ -0,0 +1,176 @@
+#include "platform/fake_compositor.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <random>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+// How often the accept loop checks whether it should stop.
+constexpr int kPollIntervalMs = 100;
+
+std::string read_message(int fd) {
+    std::string message;
+    char buffer[4096];
+    while (true) {
+        const ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        message.append(buffer, static_cast<size_t>(n));
+    }
+    return message;
+}
+
+void write_reply(int fd, const std::string& body) {
+    size_t written = 0;
+    while (written < body.size()) {
+        const ssize_t n = ::write(fd, body.data() + written, body.size() - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;
+        }
+        written += static_cast<size_t>(n);
+    }
+}
+}  // namespace
+
+namespace hyprland {
+FakeCompositor::FakeCompositor() : FakeCompositor(Options{}) {}
+
+FakeCompositor::FakeCompositor(Options options) : m_options(options) {}
+
+FakeCompositor::~FakeCompositor() {
+    stop();
+}
+
+void FakeCompositor::add_entries(const std::vector<ReplayEntry>& entries) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entry : entries) {
+        m_replies[entry.message] = entry.reply;
+    }
+}
+
+bool FakeCompositor::load_replay_file(const std::string& path) {
+    const auto entries = read_replay_file(path);
+    add_entries(entries);
+    return !entries.empty();
+}
+
+bool FakeCompositor::start(const std::string& socket_path) {
+    if (m_running) {
+        return false;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    ::unlink(socket_path.c_str());
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 16) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_socketPath = socket_path;
+    m_listenFd = fd;
+    m_running = true;
+    m_thread = std::thread(&FakeCompositor::serve, this);
+    return true;
+}
+
+void FakeCompositor::stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    ::close(m_listenFd);
+    m_listenFd = -1;
+    ::unlink(m_socketPath.c_str());
+}
+
+Reply FakeCompositor::reply_for(const std::string& message) const {
+    const std::string batchPrefix = kBatchPrefix;
+    if (message.compare(0, batchPrefix.size(), batchPrefix) == 0) {
+        // Answer each command as Hyprland does, joined by blank lines.
+        Reply reply{true, ""};
+        size_t start = batchPrefix.size();
+        while (start <= message.size()) {
+            size_t end = message.find(';', start);
+            end = end == std::string::npos ? message.size() : end;
+            std::string command = message.substr(start, end - start);
+            command.erase(0, command.find_first_not_of(' '));
+            command.erase(command.find_last_not_of(' ') + 1);
+            if (!command.empty()) {
+                reply.body += reply.body.empty() ? "" : "\n\n";
+                reply.body += reply_for(command).body;
+            }
+            start = end + 1;
+        }
+        return reply;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_replies.find(message);
+        if (it != m_replies.end()) {
+            return it->second;
+        }
+    }
+
+    if (m_options.accept_unknown_keywords && message.rfind("keyword ", 0) == 0) {
+        return {true, "ok"};
+    }
+    return {false, "unknown request"};
+}
+
+void FakeCompositor::serve() {
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<long long> jitter(-m_options.jitter.count(), m_options.jitter.count());
+
+    while (m_running) {
+        pollfd pfd{m_listenFd, POLLIN, 0};
+        if (::poll(&pfd, 1, kPollIntervalMs) <= 0) {
+            continue;
+        }
+
+        const int client = ::accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+
+        const auto delay = m_options.latency + std::chrono::milliseconds(jitter(rng));
+        if (delay.count() > 0) {
+            std::this_thread::sleep_for(delay);
+        }
+        handle_connection(client);
+        ::close(client);
+    }
+}
+
+void FakeCompositor::handle_connection(int fd) {
+    const std::string message = read_message(fd);
+    write_reply(fd, reply_for(message).body);
+    ++m_requestsServed;
+}
+}  // namespace hyprland
@@ -0,0 +1,61 @@
+#ifndef PLATFORM_FAKE_COMPOSITOR_HPP
+#define PLATFORM_FAKE_COMPOSITOR_HPP
+
+#include "platform/transport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace hyprland {
+// Serves recorded replies on a Unix socket using Hyprland's IPC protocol, so
+// the UI and tools can run against SocketTransport without a compositor.
+class FakeCompositor {
+public:
+    struct Options {
+        std::chrono::milliseconds latency{0};
+        // Each reply is delayed by latency plus a uniform offset in
+        // [-jitter, +jitter], never below zero.
+        std::chrono::milliseconds jitter{0};
+        // Answer "ok" to keywords that were never recorded.
+        bool accept_unknown_keywords = true;
+    };
+
+    FakeCompositor();
+    explicit FakeCompositor(Options options);
+    ~FakeCompositor();
+
+    FakeCompositor(const FakeCompositor&) = delete;
+    FakeCompositor& operator=(const FakeCompositor&) = delete;
+
+    // Later entries for the same message replace earlier ones.
+    void add_entries(const std::vector<ReplayEntry>& entries);
+    bool load_replay_file(const std::string& path);
+
+    bool start(const std::string& socket_path);
+    void stop();
+
+    Reply reply_for(const std::string& message) const;
+    size_t requests_served() const { return m_requestsServed.load(); }
+
+private:
+    void serve();
+    void handle_connection(int fd);
+
+    Options m_options;
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Reply> m_replies;
+    std::string m_socketPath;
+    int m_listenFd = -1;
+    std::atomic<bool> m_running{false};
+    std::atomic<size_t> m_requestsServed{0};
+    std::thread m_thread;
+};
+}  // namespace hyprland
+
+#endif
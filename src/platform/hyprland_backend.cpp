@@ -1,32 +1,37 @@
 #include "platform/hyprland_backend.hpp"
 
 #include "config_io.hpp"
+#include "core/event_ring.hpp"
+#include "core/metrics.hpp"
+#include "core/numeric_codec.hpp"
+#include "core/trace.hpp"
+#include "core/value_codec.hpp"
 
 #include <cstdlib>
-#include <exception>
+#include <initializer_list>
 #include <iostream>
 #include <json-glib/json-glib.h>
 #include <optional>
-#include <regex>
+#include <string_view>
+#include <utility>
 
 namespace {
-bool run_capture(const std::string& cmd, std::string& output) {
-    FILE* pipe = popen(cmd.c_str(), "r");
-    if (!pipe) {
-        return false;
-    }
-
-    char buffer[4096];
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        output += buffer;
-    }
-
-    return pclose(pipe) == 0;
+// Feeds both the latency histograms and the diagnostics event ring.
+void record_operation(core::metrics::Operation operation, core::EventKind kind, std::string_view name,
+                      core::metrics::Clock::time_point start, bool ok) {
+    core::metrics::record(operation, start, ok);
+    core::event_ring().push(kind, name, start, ok);
 }
 
-bool run_system(const std::string& cmd) {
-    int ret = std::system(cmd.c_str());
-    return ret == 0;
+// HYPRLAND_SETTINGS_CONFIG lets headless runs against a fake compositor write
+// somewhere other than the user's config.
+std::string default_config_path() {
+    const char* override_path = std::getenv("HYPRLAND_SETTINGS_CONFIG");
+    if (override_path && *override_path) {
+        return override_path;
+    }
+    const char* home = std::getenv("HOME");
+    return home ? std::string(home) + "/.config/hypr/hyprland.conf" : "hyprland.conf";
 }
 
 std::string json_node_to_string(JsonObject* data_obj, const char* member) {
@@ -44,10 +49,10 @@ std::string json_node_to_string(JsonObject* data_obj, const char* member) {
         return json_object_get_string_member(data_obj, member);
     }
     if (type == G_TYPE_INT64) {
-        return std::to_string(json_object_get_int_member(data_obj, member));
+        return core::format_integer(json_object_get_int_member(data_obj, member)).str();
     }
     if (type == G_TYPE_DOUBLE) {
-        return std::to_string(json_object_get_double_member(data_obj, member));
+        return core::format_shortest(json_object_get_double_member(data_obj, member)).str();
     }
     if (type == G_TYPE_BOOLEAN) {
         return json_object_get_boolean_member(data_obj, member) ? "true" : "false";
@@ -73,11 +78,7 @@ std::optional<double> json_node_to_double(JsonObject* data_obj, const char* memb
         return static_cast<double>(json_object_get_int_member(data_obj, member));
     }
     if (type == G_TYPE_STRING) {
-        try {
-            return std::stod(json_object_get_string_member(data_obj, member));
-        } catch (const std::exception&) {
-            return std::nullopt;
-        }
+        return core::parse_number(json_object_get_string_member(data_obj, member));
     }
 
     return std::nullopt;
@@ -115,7 +116,7 @@ std::string hyprland::escape_keyword_value(const std::string& value) {
 }
 
 std::string hyprland::build_keyword_command(const std::string& name, const std::string& value) {
-    return "hyprctl keyword " + name + " \"" + escape_keyword_value(value) + "\"";
+    return to_hyprctl_command({"keyword", {name, value}});
 }
 
 std::string hyprland::build_device_keyword_command(const std::string& device_name,
@@ -132,61 +133,197 @@ std::string hyprland::section_path_from_option_name(const std::string& option_na
     return option_name.substr(0, pos);
 }
 
-bool HyprlandBackend::apply_persistent_option(const std::string& name, const std::string& value) const {
-    const char* home = std::getenv("HOME");
-    std::string config_path = home ? std::string(home) + "/.config/hypr/hyprland.conf" : "hyprland.conf";
+HyprlandBackend::HyprlandBackend() : HyprlandBackend(hyprland::make_default_transport()) {}
+
+HyprlandBackend::HyprlandBackend(std::shared_ptr<hyprland::Transport> transport)
+    : m_transport(std::move(transport)), m_configPath(default_config_path()) {}
+
+const std::string& HyprlandBackend::config_path() const {
+    return m_configPath;
+}
 
-    if (!ConfigIO::updateOption(config_path, name, value)) {
+bool HyprlandBackend::send_keyword(const std::string& name, const std::string& value) const {
+    HYPRLAND_TRACE_SPAN_DETAIL("backend.keyword", name);
+    const auto start = core::metrics::Clock::now();
+    const bool ok = m_transport->send({"keyword", {name, value}}).ok;
+    record_operation(core::metrics::Operation::Keyword, core::EventKind::Keyword, name, start, ok);
+    return ok;
+}
+
+bool HyprlandBackend::apply_persistent_option(const std::string& name, const std::string& value) const {
+    const auto start = core::metrics::Clock::now();
+    const bool written = ConfigIO::updateOption(m_configPath, name, value);
+    record_operation(core::metrics::Operation::ConfigWrite, core::EventKind::ConfigWrite, name, start,
+                     written);
+    if (!written) {
         std::cerr << "Failed to update config file for: " << name << '\n';
         return false;
     }
 
-    return run_system(hyprland::build_keyword_command(name, value));
+    return send_keyword(name, value);
 }
 
 bool HyprlandBackend::apply_runtime_option(const std::string& name, const std::string& value) const {
-    return run_system(hyprland::build_keyword_command(name, value));
+    return send_keyword(name, value);
+}
+
+bool HyprlandBackend::apply_persistent_options(const OptionAssignments& options,
+                                               std::vector<std::string>* failed) const {
+    return apply_changes(options, {}, failed);
+}
+
+bool HyprlandBackend::reset_options(const OptionAssignments& defaults,
+                                    std::vector<std::string>* failed) const {
+    return apply_changes({}, defaults, failed);
+}
+
+bool HyprlandBackend::apply_changes(const OptionAssignments& values, const OptionAssignments& defaults,
+                                    std::vector<std::string>* failed) const {
+    std::vector<std::string> removed;
+    removed.reserve(defaults.size());
+    for (const auto& option : defaults) {
+        removed.push_back(option.first);
+    }
+
+    const auto start = core::metrics::Clock::now();
+    const bool written = ConfigIO::applyOptions(m_configPath, values, removed);
+    std::string detail = std::to_string(values.size()) + " options";
+    if (!removed.empty()) {
+        detail = values.empty() ? std::to_string(removed.size()) + " options removed"
+                                : detail + ", " + std::to_string(removed.size()) + " removed";
+    }
+    record_operation(core::metrics::Operation::ConfigWrite, core::EventKind::ConfigWrite, detail, start, written);
+    if (!written) {
+        std::cerr << "Failed to update config file for " << values.size() + removed.size() << " options\n";
+        if (failed) {
+            for (const auto& option : values) {
+                failed->push_back(option.first);
+            }
+            failed->insert(failed->end(), removed.begin(), removed.end());
+        }
+        return false;
+    }
+
+    if (defaults.empty()) {
+        return apply_runtime_options(values, failed);
+    }
+    OptionAssignments keywords = values;
+    keywords.insert(keywords.end(), defaults.begin(), defaults.end());
+    return apply_runtime_options(keywords, failed);
+}
+
+bool HyprlandBackend::apply_runtime_options(const OptionAssignments& options,
+                                            std::vector<std::string>* failed) const {
+    if (options.empty()) {
+        return true;
+    }
+    HYPRLAND_TRACE_SPAN("backend.keyword_batch");
+
+    std::vector<hyprland::Request> requests;
+    requests.reserve(options.size());
+    for (const auto& option : options) {
+        requests.push_back({"keyword", {option.first, option.second}});
+    }
+
+    const auto start = core::metrics::Clock::now();
+    const std::vector<hyprland::Reply> replies = m_transport->send_batch(requests);
+    bool ok = true;
+    for (size_t i = 0; i < replies.size(); ++i) {
+        if (!replies[i].ok) {
+            ok = false;
+            if (failed) {
+                failed->push_back(options[i].first);
+            }
+        }
+    }
+    record_operation(core::metrics::Operation::Keyword, core::EventKind::Keyword,
+                     std::to_string(options.size()) + " options", start, ok);
+    return ok;
 }
 
 bool HyprlandBackend::add_keyword(const std::string& type, const std::string& value) const {
-    return run_system(hyprland::build_keyword_command(type, value));
+    return send_keyword(type, value);
 }
 
 bool HyprlandBackend::add_device_config(const std::string& device_name, const std::string& option,
                                         const std::string& value) const {
-    return run_system(hyprland::build_device_keyword_command(device_name, option, value));
+    return send_keyword("device:" + device_name + ":" + option, value);
 }
 
-std::vector<std::string> HyprlandBackend::get_available_devices() const {
-    std::vector<std::string> devices;
-    std::string output;
-    if (!run_capture("hyprctl -j devices", output)) {
-        return devices;
+std::vector<OptionState> HyprlandBackend::refresh_options(const std::vector<std::string>& names) const {
+    std::vector<OptionState> states;
+    if (names.empty()) {
+        return states;
     }
+    HYPRLAND_TRACE_SPAN("backend.refresh_options");
 
-    std::regex name_regex("\\\"name\\\":\\s*\\\"([^\\\"]+)\\\"");
-    std::smatch match;
-    std::string::const_iterator search_start(output.cbegin());
-    while (std::regex_search(search_start, output.cend(), match, name_regex)) {
-        devices.push_back(match[1]);
-        search_start = match.suffix().first;
+    std::vector<hyprland::Request> requests;
+    requests.reserve(names.size());
+    for (const auto& name : names) {
+        requests.push_back({"getoption", {name}, true});
     }
 
-    return devices;
+    const auto start = core::metrics::Clock::now();
+    const std::vector<hyprland::Reply> replies = m_transport->send_batch(requests);
+    bool ok = true;
+    states.reserve(names.size());
+    for (size_t i = 0; i < replies.size(); ++i) {
+        core::metrics::add(core::metrics::Counter::BytesRead, replies[i].body.size());
+        OptionState state;
+        if (!replies[i].ok || !hyprland::parse_getoption_json(replies[i].body, state)) {
+            ok = false;
+            continue;
+        }
+        state.name = names[i];
+        states.push_back(std::move(state));
+    }
+    record_operation(core::metrics::Operation::GetOption, core::EventKind::GetOption,
+                     std::to_string(names.size()) + " options", start, ok);
+    return states;
+}
+
+std::vector<InputDevice> HyprlandBackend::get_available_devices() const {
+    HYPRLAND_TRACE_SPAN("backend.devices");
+    const auto start = core::metrics::Clock::now();
+    const hyprland::Reply reply = m_transport->send({"devices", {}, true});
+    record_operation(core::metrics::Operation::Devices, core::EventKind::Devices, "", start, reply.ok);
+    core::metrics::add(core::metrics::Counter::BytesRead, reply.body.size());
+    if (!reply.ok) {
+        return {};
+    }
+    return hyprland::parse_devices_json(reply.body);
 }
 
 SettingsSnapshot HyprlandBackend::load_snapshot() const {
-    SettingsSnapshot snapshot;
+    HYPRLAND_TRACE_SPAN("backend.load_snapshot");
+    SettingsSnapshot snapshot = load_options();
     snapshot.available_devices = get_available_devices();
+    return snapshot;
+}
 
-    std::string json_output;
-    if (!run_capture("hyprctl descriptions -j", json_output)) {
-        return snapshot;
+SettingsSnapshot HyprlandBackend::load_options() const {
+    hyprland::Reply reply;
+    {
+        HYPRLAND_TRACE_SPAN("backend.descriptions");
+        const auto start = core::metrics::Clock::now();
+        reply = m_transport->send({"descriptions", {}, true});
+        record_operation(core::metrics::Operation::Descriptions, core::EventKind::Descriptions, "", start,
+                         reply.ok);
+        core::metrics::add(core::metrics::Counter::BytesRead, reply.body.size());
     }
+    if (!reply.ok) {
+        return {};
+    }
+    return hyprland::parse_descriptions_json(reply.body);
+}
+
+SettingsSnapshot hyprland::parse_descriptions_json(const std::string& json) {
+    HYPRLAND_TRACE_SPAN("backend.parse_descriptions");
+    SettingsSnapshot snapshot;
 
     GError* error = nullptr;
     JsonParser* parser = json_parser_new();
-    bool parsed = json_parser_load_from_data(parser, json_output.c_str(), -1, &error);
+    bool parsed = json_parser_load_from_data(parser, json.c_str(), static_cast<gssize>(json.size()), &error);
     if (!parsed) {
         if (error) {
             g_error_free(error);
@@ -219,11 +356,14 @@ SettingsSnapshot HyprlandBackend::load_snapshot() const {
         if (json_object_has_member(obj, "type")) {
             option.value_type = static_cast<int>(json_object_get_int_member(obj, "type"));
         }
+        const core::ValueType type = core::value_type_from_id(option.value_type);
 
         if (json_object_has_member(obj, "data")) {
             JsonObject* data_obj = json_object_get_object_member(obj, "data");
-            if (option.value_type == 6) {
+            if (type == core::ValueType::Choice) {
                 option.choice_values_csv = json_string_member_if_string(data_obj, "value");
+            } else {
+                option.default_value = json_node_to_string(data_obj, "value");
             }
 
             option.value = json_node_to_string(data_obj, "current");
@@ -242,7 +382,15 @@ SettingsSnapshot HyprlandBackend::load_snapshot() const {
                 option.range_max = max_value.value();
             }
 
-            if (option.value_type == 8) {
+            if (type == core::ValueType::Vec2) {
+                // Vec2 entries carry their default as data.x and data.y.
+                auto x = json_node_to_double(data_obj, "x");
+                auto y = json_node_to_double(data_obj, "y");
+                if (option.default_value.empty() && x.has_value() && y.has_value()) {
+                    option.default_value = core::format_vector_value(
+                        *x, *y, core::has_fractional_component(*x) || core::has_fractional_component(*y));
+                }
+
                 auto min_x = json_node_to_double(data_obj, "min_x");
                 auto min_y = json_node_to_double(data_obj, "min_y");
                 auto max_x = json_node_to_double(data_obj, "max_x");
@@ -257,16 +405,11 @@ SettingsSnapshot HyprlandBackend::load_snapshot() const {
             }
         }
 
-        if (option.value_type == 0) {
-            if (option.value == "1" || option.value == "true") {
-                option.value = "true";
-            } else if (option.value == "0" || option.value == "false") {
-                option.value = "false";
+        for (std::string* field : {&option.value, &option.default_value}) {
+            if (auto normalized = core::normalize_value(type, *field)) {
+                *field = std::move(*normalized);
             }
         }
-        if ((option.value_type == 3 || option.value_type == 4) && option.value == "[[EMPTY]]") {
-            option.value.clear();
-        }
 
         option.section_path = hyprland::section_path_from_option_name(option.name);
         if (!option.section_path.empty()) {
@@ -281,3 +424,85 @@ SettingsSnapshot HyprlandBackend::load_snapshot() const {
     g_object_unref(parser);
     return snapshot;
 }
+
+bool hyprland::parse_getoption_json(const std::string& json, OptionState& state) {
+    JsonParser* parser = json_parser_new();
+    if (!json_parser_load_from_data(parser, json.c_str(), -1, nullptr)) {
+        g_object_unref(parser);
+        return false;
+    }
+
+    JsonNode* root = json_parser_get_root(parser);
+    if (!root || !JSON_NODE_HOLDS_OBJECT(root)) {
+        g_object_unref(parser);
+        return false;
+    }
+
+    JsonObject* obj = json_node_get_object(root);
+    bool found = false;
+    for (const char* member : {"int", "float", "str", "custom"}) {
+        if (json_object_has_member(obj, member)) {
+            state.value = json_node_to_string(obj, member);
+            found = true;
+            break;
+        }
+    }
+    if (!found && json_object_has_member(obj, "vec2")) {
+        JsonNode* node = json_object_get_member(obj, "vec2");
+        JsonArray* vec = node && JSON_NODE_HOLDS_ARRAY(node) ? json_node_get_array(node) : nullptr;
+        if (vec && json_array_get_length(vec) == 2) {
+            state.value = core::format_shortest(json_node_get_double(json_array_get_element(vec, 0))).str() + " " +
+                          core::format_shortest(json_node_get_double(json_array_get_element(vec, 1))).str();
+            found = true;
+        }
+    }
+    if (json_object_has_member(obj, "set")) {
+        state.set_by_user = json_object_get_boolean_member(obj, "set");
+    }
+
+    g_object_unref(parser);
+    return found;
+}
+
+std::vector<InputDevice> hyprland::parse_devices_json(const std::string& json) {
+    std::vector<InputDevice> devices;
+    JsonParser* parser = json_parser_new();
+    if (!json_parser_load_from_data(parser, json.c_str(), -1, nullptr)) {
+        g_object_unref(parser);
+        return devices;
+    }
+
+    JsonNode* root = json_parser_get_root(parser);
+    if (!root || !JSON_NODE_HOLDS_OBJECT(root)) {
+        g_object_unref(parser);
+        return devices;
+    }
+
+    const std::pair<const char*, DeviceClass> groups[] = {
+        {"keyboards", DeviceClass::Keyboard},
+        {"mice", DeviceClass::Pointer},
+        {"touch", DeviceClass::Touch},
+        {"tablets", DeviceClass::Tablet},
+    };
+    JsonObject* obj = json_node_get_object(root);
+    for (const auto& group : groups) {
+        JsonNode* node = json_object_get_member(obj, group.first);
+        if (!node || !JSON_NODE_HOLDS_ARRAY(node)) {
+            continue;
+        }
+        JsonArray* entries = json_node_get_array(node);
+        for (guint i = 0; i < json_array_get_length(entries); ++i) {
+            JsonNode* entry = json_array_get_element(entries, i);
+            if (!JSON_NODE_HOLDS_OBJECT(entry)) {
+                continue;
+            }
+            std::string name = json_node_to_string(json_node_get_object(entry), "name");
+            if (!name.empty()) {
+                devices.push_back({std::move(name), group.second});
+            }
+        }
+    }
+
+    g_object_unref(parser);
+    return devices;
+}
@@ -2,8 +2,11 @@
 #define HYPRLAND_BACKEND_HPP
 
 #include "core/models.hpp"
+#include "platform/transport.hpp"
 
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace hyprland {
 std::string escape_keyword_value(const std::string& value);
@@ -11,18 +14,56 @@ std::string build_keyword_command(const std::string& name, const std::string& va
 std::string build_device_keyword_command(const std::string& device_name, const std::string& option,
                                          const std::string& value);
 std::string section_path_from_option_name(const std::string& option_name);
+// Options from `hyprctl descriptions -j` output. Devices are left empty.
+SettingsSnapshot parse_descriptions_json(const std::string& json);
+// One `hyprctl getoption -j` reply.
+bool parse_getoption_json(const std::string& json, OptionState& state);
+// Named devices from `hyprctl devices -j` output, by class. Switches and
+// unnamed entries such as tablet tools take no device block and are skipped.
+std::vector<InputDevice> parse_devices_json(const std::string& json);
 }
 
 class HyprlandBackend {
 public:
+    // Uses hyprland::make_default_transport().
+    HyprlandBackend();
+    explicit HyprlandBackend(std::shared_ptr<hyprland::Transport> transport);
+
     bool apply_persistent_option(const std::string& name, const std::string& value) const;
     bool apply_runtime_option(const std::string& name, const std::string& value) const;
+    // One config write, then every keyword in a single batch. Names that
+    // were rejected are appended to failed when it is given.
+    bool apply_persistent_options(const OptionAssignments& options,
+                                  std::vector<std::string>* failed = nullptr) const;
+    bool apply_runtime_options(const OptionAssignments& options,
+                               std::vector<std::string>* failed = nullptr) const;
+    // Removes the options' assignments from the config in one write, then
+    // applies the given defaults in one batch.
+    bool reset_options(const OptionAssignments& defaults,
+                       std::vector<std::string>* failed = nullptr) const;
+    // Both of the above at once: one config write that drops the defaults'
+    // assignments and appends values, then one batch with every keyword.
+    bool apply_changes(const OptionAssignments& values, const OptionAssignments& defaults,
+                       std::vector<std::string>* failed = nullptr) const;
     bool add_keyword(const std::string& type, const std::string& value) const;
     bool add_device_config(const std::string& device_name, const std::string& option,
                            const std::string& value) const;
 
-    std::vector<std::string> get_available_devices() const;
+    std::vector<InputDevice> get_available_devices() const;
     SettingsSnapshot load_snapshot() const;
+    // load_snapshot without the device list.
+    SettingsSnapshot load_options() const;
+    // Current values of just these options, from one batch of getoption
+    // queries. Options Hyprland does not answer for are left out.
+    std::vector<OptionState> refresh_options(const std::vector<std::string>& names) const;
+    // The config file persistent writes go to.
+    const std::string& config_path() const;
+
+private:
+    bool send_keyword(const std::string& name, const std::string& value) const;
+
+    std::shared_ptr<hyprland::Transport> m_transport;
+    std::string m_configPath;
 };
 
 #endif
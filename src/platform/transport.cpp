@@ -0,0 +1,421 @@
+#include "platform/transport.hpp"
+
+#include "core/metrics.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+// Long enough for `descriptions` on a loaded session, short enough that a
+// wedged compositor does not hang the UI forever.
+constexpr int kSocketTimeoutSeconds = 10;
+// Hyprland's socket refuses connections with EAGAIN while its backlog is
+// full; a short wait is usually enough.
+constexpr int kConnectAttempts = 3;
+constexpr auto kConnectRetryDelay = std::chrono::milliseconds(5);
+
+std::string quote_argument(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') {
+            quoted += "\\\"";
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+bool connect_with_retry(int fd, const sockaddr_un& address) {
+    for (int attempt = 1;; ++attempt) {
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) {
+            return true;
+        }
+        if (errno != EAGAIN || attempt == kConnectAttempts) {
+            return false;
+        }
+        core::metrics::add(core::metrics::Counter::Retries);
+        std::this_thread::sleep_for(kConnectRetryDelay);
+    }
+}
+
+hyprland::Reply run_hyprctl(const std::string& command) {
+    hyprland::Reply reply;
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) {
+        return reply;
+    }
+
+    char buffer[4096];
+    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
+        reply.body += buffer;
+    }
+    reply.ok = pclose(pipe) == 0;
+    return reply;
+}
+
+// Whether a batch reply says every one of its commands succeeded: one "ok"
+// per command, however Hyprland separated them.
+bool all_ok(const std::string& body, size_t commands) {
+    std::string compact;
+    for (char c : body) {
+        if (!std::isspace(static_cast<unsigned char>(c))) {
+            compact += c;
+        }
+    }
+    if (compact.size() != commands * 2) {
+        return false;
+    }
+    for (size_t i = 0; i < compact.size(); i += 2) {
+        if (compact.compare(i, 2, "ok") != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+using BatchSender = std::function<hyprland::Reply(const std::vector<std::string>&)>;
+
+// Sends the requests at the given indices as one batch. Plain commands must
+// all answer "ok"; JSON queries must give one value each. Anything else is
+// retried request by request so the caller learns which ones failed.
+void send_group(hyprland::Transport& transport,
+                const std::vector<hyprland::Request>& requests,
+                const std::vector<size_t>& group,
+                bool json,
+                const BatchSender& send_batched,
+                std::vector<hyprland::Reply>& replies) {
+    if (group.size() == 1) {
+        replies[group[0]] = transport.send(requests[group[0]]);
+    }
+    if (group.size() <= 1) {
+        return;
+    }
+
+    std::vector<std::string> messages;
+    messages.reserve(group.size());
+    for (size_t index : group) {
+        messages.push_back(hyprland::to_ipc_message(requests[index]));
+    }
+    const hyprland::Reply reply = send_batched(messages);
+
+    std::vector<std::string> values;
+    bool ok = reply.ok;
+    if (ok && json) {
+        values = hyprland::split_json_values(reply.body);
+        ok = values.size() == group.size();
+    } else if (ok) {
+        ok = all_ok(reply.body, group.size());
+    }
+    for (size_t i = 0; i < group.size(); ++i) {
+        if (!ok) {
+            replies[group[i]] = transport.send(requests[group[i]]);
+        } else {
+            replies[group[i]] = hyprland::Reply{true, json ? std::move(values[i]) : "ok"};
+        }
+    }
+}
+
+// Sends the batchable requests through send_batched, commands and queries
+// in a batch each, and the rest one by one.
+std::vector<hyprland::Reply> send_in_batches(
+    hyprland::Transport& transport,
+    const std::vector<hyprland::Request>& requests,
+    const BatchSender& send_batched) {
+    std::vector<hyprland::Reply> replies(requests.size());
+    std::vector<size_t> commands;
+    std::vector<size_t> queries;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (!hyprland::batchable(requests[i])) {
+            replies[i] = transport.send(requests[i]);
+        } else if (requests[i].json) {
+            queries.push_back(i);
+        } else {
+            commands.push_back(i);
+        }
+    }
+
+    send_group(transport, requests, commands, false, send_batched, replies);
+    send_group(transport, requests, queries, true, send_batched, replies);
+    return replies;
+}
+
+bool write_all(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        const ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool read_all(int fd, std::string& out) {
+    char buffer[8192];
+    while (true) {
+        const ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n == 0) {
+            return true;
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        out.append(buffer, static_cast<size_t>(n));
+    }
+}
+}  // namespace
+
+namespace hyprland {
+std::string to_ipc_message(const Request& request) {
+    std::string message = request.json ? "j/" : "";
+    message += request.command;
+    for (const auto& arg : request.args) {
+        message += ' ';
+        message += arg;
+    }
+    return message;
+}
+
+std::string to_hyprctl_command(const Request& request) {
+    std::string command = "hyprctl ";
+    if (request.json) {
+        command += "-j ";
+    }
+    command += request.command;
+    for (size_t i = 0; i < request.args.size(); ++i) {
+        command += ' ';
+        command += i == 0 ? request.args[i] : quote_argument(request.args[i]);
+    }
+    return command;
+}
+
+bool batchable(const Request& request) {
+    const auto hasSemicolon = [](const std::string& text) { return text.find(';') != std::string::npos; };
+    if (hasSemicolon(request.command)) {
+        return false;
+    }
+    for (const auto& arg : request.args) {
+        if (hasSemicolon(arg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> split_json_values(const std::string& text) {
+    std::vector<std::string> values;
+    size_t start = 0;
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        if (inString) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                inString = false;
+            }
+            continue;
+        }
+
+        if (depth == 0) {
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                continue;
+            }
+            if (c != '{' && c != '[') {
+                return {};
+            }
+            start = i;
+        }
+
+        if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (--depth == 0) {
+                values.push_back(text.substr(start, i - start + 1));
+            }
+        }
+    }
+    if (depth != 0 || inString) {
+        return {};
+    }
+    return values;
+}
+
+std::vector<Reply> Transport::send_batch(const std::vector<Request>& requests) {
+    std::vector<Reply> replies;
+    replies.reserve(requests.size());
+    for (const auto& request : requests) {
+        replies.push_back(send(request));
+    }
+    return replies;
+}
+
+Reply ProcessTransport::send(const Request& request) {
+    return run_hyprctl(to_hyprctl_command(request));
+}
+
+std::vector<Reply> ProcessTransport::send_batch(const std::vector<Request>& requests) {
+    return send_in_batches(*this, requests, [](const std::vector<std::string>& messages) {
+        std::string batch;
+        for (const auto& message : messages) {
+            batch += batch.empty() ? "" : " ; ";
+            batch += message;
+        }
+        return run_hyprctl("hyprctl --batch " + quote_argument(batch));
+    });
+}
+
+SocketTransport::SocketTransport(std::string socket_path) : m_socketPath(std::move(socket_path)) {}
+
+Reply SocketTransport::send(const Request& request) {
+    return send_message(to_ipc_message(request), request.json);
+}
+
+std::vector<Reply> SocketTransport::send_batch(const std::vector<Request>& requests) {
+    return send_in_batches(*this, requests, [this](const std::vector<std::string>& messages) {
+        std::string batch = kBatchPrefix;
+        for (size_t i = 0; i < messages.size(); ++i) {
+            batch += i == 0 ? "" : ";";
+            batch += messages[i];
+        }
+        // Any answer counts here; send_in_batches checks what it says.
+        return send_message(batch, true);
+    });
+}
+
+Reply SocketTransport::send_message(const std::string& message, bool json) {
+    Reply reply;
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (m_socketPath.size() >= sizeof(address.sun_path)) {
+        return reply;
+    }
+    std::memcpy(address.sun_path, m_socketPath.c_str(), m_socketPath.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return reply;
+    }
+
+    timeval timeout{};
+    timeout.tv_sec = kSocketTimeoutSeconds;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    bool received = false;
+    if (connect_with_retry(fd, address) &&
+        write_all(fd, message)) {
+        ::shutdown(fd, SHUT_WR);
+        received = read_all(fd, reply.body);
+    }
+    ::close(fd);
+
+    // Hyprland answers plain commands with "ok" and anything else is an error
+    // message; JSON queries just need an answer.
+    reply.ok = received && (json ? !reply.body.empty() : reply.body == "ok");
+    return reply;
+}
+
+std::vector<ReplayEntry> read_replay_file(const std::string& path) {
+    std::vector<ReplayEntry> entries;
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("request ", 0) != 0) {
+            continue;
+        }
+        ReplayEntry entry;
+        entry.message = line.substr(8);
+
+        std::string status;
+        size_t length = 0;
+        if (!(in >> line >> status >> length) || line != "reply") {
+            break;
+        }
+        in.get();  // Newline after the header.
+
+        entry.reply.ok = status == "ok";
+        entry.reply.body.resize(length);
+        if (length > 0 && !in.read(&entry.reply.body[0], static_cast<std::streamsize>(length))) {
+            break;
+        }
+        in.get();  // Newline after the body.
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+bool append_replay_entry(const std::string& path, const ReplayEntry& entry) {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    if (!out.is_open()) {
+        return false;
+    }
+    out << "request " << entry.message << '\n'
+        << "reply " << (entry.reply.ok ? "ok" : "error") << ' ' << entry.reply.body.size() << '\n'
+        << entry.reply.body << '\n';
+    return static_cast<bool>(out);
+}
+
+RecordingTransport::RecordingTransport(std::shared_ptr<Transport> inner, std::string replay_path)
+    : m_inner(std::move(inner)), m_replayPath(std::move(replay_path)) {}
+
+Reply RecordingTransport::send(const Request& request) {
+    Reply reply = m_inner->send(request);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    append_replay_entry(m_replayPath, {to_ipc_message(request), reply});
+    return reply;
+}
+
+std::vector<Reply> RecordingTransport::send_batch(const std::vector<Request>& requests) {
+    std::vector<Reply> replies = m_inner->send_batch(requests);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        append_replay_entry(m_replayPath, {to_ipc_message(requests[i]), replies[i]});
+    }
+    return replies;
+}
+
+std::shared_ptr<Transport> make_default_transport() {
+    std::shared_ptr<Transport> transport;
+    const char* socket = std::getenv("HYPRLAND_SETTINGS_SOCKET");
+    if (socket && *socket) {
+        transport = std::make_shared<SocketTransport>(socket);
+    } else {
+        transport = std::make_shared<ProcessTransport>();
+    }
+
+    const char* record = std::getenv("HYPRLAND_SETTINGS_RECORD");
+    if (record && *record) {
+        transport = std::make_shared<RecordingTransport>(std::move(transport), record);
+    }
+    return transport;
+}
+}  // namespace hyprland
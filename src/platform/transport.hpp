@@ -0,0 +1,104 @@
+#ifndef PLATFORM_TRANSPORT_HPP
+#define PLATFORM_TRANSPORT_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hyprland {
+// One hyprctl command, e.g. {"keyword", {"general:border_size", "2"}} or
+// {"descriptions", {}, true}.
+struct Request {
+    std::string command;
+    std::vector<std::string> args;
+    bool json = false;
+};
+
+struct Reply {
+    bool ok = false;
+    std::string body;
+};
+
+// Hyprland's socket message for a request: "j/descriptions",
+// "keyword general:border_size 2".
+std::string to_ipc_message(const Request& request);
+// hyprctl invocation for a request, with every argument after the first quoted.
+std::string to_hyprctl_command(const Request& request);
+
+// Prefix of a socket message carrying several ';'-separated commands.
+constexpr const char* kBatchPrefix = "[[BATCH]]";
+// Whether a request can ride in a batch: commands whose text has no ';'.
+// Plain commands and JSON queries go in separate batches.
+bool batchable(const Request& request);
+// Splits a batch of JSON replies, which Hyprland concatenates, into one
+// string per top-level value. Empty if the text is not a sequence of JSON
+// objects and arrays.
+std::vector<std::string> split_json_values(const std::string& text);
+
+// Carries requests to the compositor. Implementations must be safe to call
+// from the snapshot prefetch thread and the UI thread at once.
+class Transport {
+public:
+    virtual ~Transport() = default;
+    virtual Reply send(const Request& request) = 0;
+    // Replies line up with requests. The default sends them one at a time;
+    // the real transports use Hyprland's batch command instead.
+    virtual std::vector<Reply> send_batch(const std::vector<Request>& requests);
+};
+
+// Runs hyprctl.
+class ProcessTransport : public Transport {
+public:
+    Reply send(const Request& request) override;
+    std::vector<Reply> send_batch(const std::vector<Request>& requests) override;
+};
+
+// Talks Hyprland's IPC protocol over a Unix socket: Hyprland's own
+// .socket.sock or a FakeCompositor.
+class SocketTransport : public Transport {
+public:
+    explicit SocketTransport(std::string socket_path);
+    Reply send(const Request& request) override;
+    std::vector<Reply> send_batch(const std::vector<Request>& requests) override;
+
+private:
+    Reply send_message(const std::string& message, bool json);
+
+    std::string m_socketPath;
+};
+
+// One request and the reply it got, as stored in a replay file.
+struct ReplayEntry {
+    std::string message;
+    Reply reply;
+};
+
+// Replay files are a sequence of
+//   request <ipc message>\n
+//   reply <ok|error> <body length>\n
+//   <body>\n
+std::vector<ReplayEntry> read_replay_file(const std::string& path);
+bool append_replay_entry(const std::string& path, const ReplayEntry& entry);
+
+// Forwards to another transport and appends every exchange to a replay file.
+class RecordingTransport : public Transport {
+public:
+    RecordingTransport(std::shared_ptr<Transport> inner, std::string replay_path);
+    Reply send(const Request& request) override;
+    // Recorded as one entry per request, which FakeCompositor answers
+    // batches from.
+    std::vector<Reply> send_batch(const std::vector<Request>& requests) override;
+
+private:
+    std::shared_ptr<Transport> m_inner;
+    std::string m_replayPath;
+    std::mutex m_mutex;
+};
+
+// hyprctl by default; a socket when HYPRLAND_SETTINGS_SOCKET names one, and
+// recorded to HYPRLAND_SETTINGS_RECORD when that is set.
+std::shared_ptr<Transport> make_default_transport();
+}  // namespace hyprland
+
+#endif
@@ -1,17 +1,26 @@
 #include "ui/devices_panel.hpp"
 
+#include "ui/option_value_editor.hpp"
+
 namespace ui {
 DevicesPanel::DevicesPanel(
-    const std::vector<std::string>& available_devices,
-    const std::vector<std::string>& available_options,
+    const std::vector<InputDevice>& available_devices,
+    const features::DeviceSchema& schema,
+    const std::vector<ConfigOptionData>& options,
+    Gtk::ScrolledWindow& content_scroll,
     const Glib::RefPtr<Gio::ListStore<DeviceConfigItem>>& device_store,
-    const std::function<void(const std::string&, const std::string&, const std::string&)>& on_add_device_config,
+    const std::function<bool(const std::string&, const std::string&, const std::string&)>& on_add_device_config,
     const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_device_name,
     const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_device_option,
     const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_device_value,
     const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& bind_device_name,
     const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& bind_device_option,
-    const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& bind_device_value) {
+    const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& bind_device_value)
+    : m_devices(available_devices),
+      m_schema(schema),
+      m_options(options),
+      m_deviceStore(device_store),
+      m_onAddDeviceConfig(on_add_device_config) {
     m_root = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
     m_root->set_spacing(10);
 
@@ -25,55 +34,53 @@ DevicesPanel::DevicesPanel(
     addBox->set_spacing(5);
     addBox->set_margin(10);
 
-    auto deviceCombo = Gtk::make_managed<Gtk::DropDown>();
     auto deviceModel = Gtk::StringList::create({});
-    deviceCombo->set_model(deviceModel);
-
-    for (const auto& device : available_devices) {
-        deviceModel->append(device);
-    }
-    if (!available_devices.empty()) {
-        deviceCombo->set_selected(0);
-    }
-
-    auto optionCombo = Gtk::make_managed<Gtk::DropDown>();
-    auto optionModel = Gtk::StringList::create({});
-    for (const auto& option : available_options) {
-        optionModel->append(option);
+    for (const auto& device : m_devices) {
+        deviceModel->append(device.name + " (" + features::device_class_name(device.device_class) + ")");
     }
-    optionCombo->set_model(optionModel);
-    if (!available_options.empty()) {
-        optionCombo->set_selected(0);
+    m_deviceDropDown = Gtk::make_managed<Gtk::DropDown>();
+    m_deviceDropDown->set_model(deviceModel);
+    if (!m_devices.empty()) {
+        m_deviceDropDown->set_selected(0);
     }
 
-    auto valueEntry = Gtk::make_managed<Gtk::Entry>();
-    valueEntry->set_placeholder_text("Value...");
-    valueEntry->set_hexpand(true);
-
-    auto addButton = Gtk::make_managed<Gtk::Button>("Apply");
-    addButton->signal_clicked().connect([device_store, on_add_device_config, deviceCombo, deviceModel, optionCombo, optionModel, valueEntry]() {
-        auto deviceIdx = deviceCombo->get_selected();
-        auto optionIdx = optionCombo->get_selected();
-        if (deviceIdx == GTK_INVALID_LIST_POSITION || optionIdx == GTK_INVALID_LIST_POSITION) {
-            return;
-        }
-
-        const std::string deviceName = deviceModel->get_string(deviceIdx);
-        const std::string option = optionModel->get_string(optionIdx);
-        const std::string value = valueEntry->get_text();
-        if (value.empty()) {
-            return;
+    for (size_t c = 0; c < kDeviceClassCount; ++c) {
+        m_optionModels[c] = Gtk::StringList::create({});
+        for (const auto& option : m_schema.options(static_cast<DeviceClass>(c))) {
+            m_optionModels[c]->append(option.name);
         }
-
-        on_add_device_config(deviceName, option, value);
-        device_store->append(DeviceConfigItem::create(deviceName, option, value));
-        valueEntry->set_text("");
+    }
+    m_optionDropDown = Gtk::make_managed<Gtk::DropDown>();
+    m_optionDropDown->set_enable_search(true);
+    m_optionDropDown->set_expression(
+        Gtk::PropertyExpression<Glib::ustring>::create(Gtk::StringObject::get_type(), "string"));
+
+    // The same typed editor the variables view uses, over a one-row model.
+    m_editorStore = Gio::ListStore<ConfigItem>::create();
+    auto editorFactory = Gtk::SignalListItemFactory::create();
+    editorFactory->signal_setup().connect([this, &content_scroll](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+        setup_option_value_editor(
+            list_item, content_scroll, m_bindingProgrammatically,
+            [this](const std::string&, const core::OptionValue& value) { return apply_value(value); },
+            // Device keywords are sent once the drag ends, not on every step.
+            [](const std::string&, const core::OptionValue&) {},
+            [](size_t) {});
     });
-
-    addBox->append(*deviceCombo);
-    addBox->append(*optionCombo);
-    addBox->append(*valueEntry);
-    addBox->append(*addButton);
+    editorFactory->signal_bind().connect([this](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+        bind_option_value_editor(list_item, m_bindingProgrammatically);
+    });
+    auto editorView = Gtk::make_managed<Gtk::ListView>(Gtk::NoSelection::create(m_editorStore), editorFactory);
+    editorView->set_hexpand(true);
+
+    m_deviceDropDown->property_selected().signal_changed().connect(
+        sigc::mem_fun(*this, &DevicesPanel::on_device_changed));
+    m_optionDropDown->property_selected().signal_changed().connect(
+        sigc::mem_fun(*this, &DevicesPanel::show_editor));
+    on_device_changed();
+
+    addBox->append(*m_deviceDropDown);
+    addBox->append(*m_optionDropDown);
+    addBox->append(*editorView);
     addFrame->set_child(*addBox);
     m_root->append(*addFrame);
 
@@ -109,4 +116,71 @@ DevicesPanel::DevicesPanel(
 Gtk::Box* DevicesPanel::widget() const {
     return m_root;
 }
+
+const InputDevice* DevicesPanel::selected_device() const {
+    const guint index = m_deviceDropDown->get_selected();
+    return index < m_devices.size() ? &m_devices[index] : nullptr;
+}
+
+const features::DeviceOption* DevicesPanel::selected_option() const {
+    const InputDevice* device = selected_device();
+    if (!device) {
+        return nullptr;
+    }
+    const auto& options = m_schema.options(device->device_class);
+    const guint index = m_optionDropDown->get_selected();
+    return index < options.size() ? &options[index] : nullptr;
+}
+
+void DevicesPanel::on_device_changed() {
+    const InputDevice* device = selected_device();
+    // Only the option list of the device's class is offered.
+    const auto& model = m_optionModels[static_cast<size_t>(device ? device->device_class : DeviceClass::Pointer)];
+    if (m_optionDropDown->get_model() != model) {
+        m_optionDropDown->set_model(model);
+    }
+    show_editor();
+}
+
+void DevicesPanel::show_editor() {
+    const InputDevice* device = selected_device();
+    const features::DeviceOption* option = selected_option();
+    if (!device || !option || option->option_index >= m_options.size()) {
+        m_editorStore->remove_all();
+        return;
+    }
+
+    // Start from the device's own value when one was set, else the global one.
+    ConfigOptionData data = m_options[option->option_index];
+    for (guint i = 0; i < m_deviceStore->get_n_items(); ++i) {
+        auto item = m_deviceStore->get_item(i);
+        if (item->m_deviceName == device->name && item->m_option == option->name) {
+            data.value = item->m_value;
+        }
+    }
+
+    auto item = make_config_item(data);
+    item->m_optionIndex = option->option_index;
+    m_editorStore->splice(0, m_editorStore->get_n_items(), {item});
+}
+
+bool DevicesPanel::apply_value(const core::OptionValue& value) {
+    const InputDevice* device = selected_device();
+    const features::DeviceOption* option = selected_option();
+    if (!device || !option || !m_onAddDeviceConfig(device->name, option->name, value.str())) {
+        return false;
+    }
+
+    // One row per device and option, holding the latest value.
+    auto entry = DeviceConfigItem::create(device->name, option->name, value.str());
+    for (guint i = 0; i < m_deviceStore->get_n_items(); ++i) {
+        auto item = m_deviceStore->get_item(i);
+        if (item->m_deviceName == device->name && item->m_option == option->name) {
+            m_deviceStore->splice(i, 1, {entry});
+            return true;
+        }
+    }
+    m_deviceStore->append(entry);
+    return true;
+}
 }  // namespace ui
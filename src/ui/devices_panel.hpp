@@ -1,10 +1,13 @@
 #ifndef UI_DEVICES_PANEL_HPP
 #define UI_DEVICES_PANEL_HPP
 
+#include "core/models.hpp"
+#include "features/device_schema.hpp"
 #include "ui/item_models.hpp"
 
 #include <gtkmm.h>
 
+#include <array>
 #include <functional>
 #include <string>
 #include <vector>
@@ -12,11 +15,15 @@
 namespace ui {
 class DevicesPanel {
 public:
+    // The schema and options must outlive the panel. on_add_device_config
+    // returns whether Hyprland took the value.
     DevicesPanel(
-        const std::vector<std::string>& available_devices,
-        const std::vector<std::string>& available_options,
+        const std::vector<InputDevice>& available_devices,
+        const features::DeviceSchema& schema,
+        const std::vector<ConfigOptionData>& options,
+        Gtk::ScrolledWindow& content_scroll,
         const Glib::RefPtr<Gio::ListStore<DeviceConfigItem>>& device_store,
-        const std::function<void(const std::string&, const std::string&, const std::string&)>& on_add_device_config,
+        const std::function<bool(const std::string&, const std::string&, const std::string&)>& on_add_device_config,
         const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_device_name,
         const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_device_option,
         const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_device_value,
@@ -27,7 +34,26 @@ public:
     Gtk::Box* widget() const;
 
 private:
+    const InputDevice* selected_device() const;
+    const features::DeviceOption* selected_option() const;
+    void on_device_changed();
+    void show_editor();
+    bool apply_value(const core::OptionValue& value);
+
+    std::vector<InputDevice> m_devices;
+    const features::DeviceSchema& m_schema;
+    const std::vector<ConfigOptionData>& m_options;
+    Glib::RefPtr<Gio::ListStore<DeviceConfigItem>> m_deviceStore;
+    std::function<bool(const std::string&, const std::string&, const std::string&)> m_onAddDeviceConfig;
+    // Option names per device class, in schema order.
+    std::array<Glib::RefPtr<Gtk::StringList>, kDeviceClassCount> m_optionModels;
+    // The one row the typed editor shows.
+    Glib::RefPtr<Gio::ListStore<ConfigItem>> m_editorStore;
+    bool m_bindingProgrammatically = false;
+
     Gtk::Box* m_root = nullptr;
+    Gtk::DropDown* m_deviceDropDown = nullptr;
+    Gtk::DropDown* m_optionDropDown = nullptr;
 };
 }  // namespace ui
 
@@ -0,0 +1,123 @@
+#include "ui/diagnostics_page.hpp"
+
+#include "core/event_ring.hpp"
+#include "core/metrics.hpp"
+
+#include <cstdio>
+
+namespace {
+constexpr unsigned kRefreshIntervalMs = 250;
+// Matches the ring, so the log never shows more than could be replayed.
+constexpr int kMaxLogLines = static_cast<int>(core::EventRing::kCapacity);
+
+std::string format_event(const core::Event& event, uint64_t origin_ns) {
+    char line[192];
+    // Events from other threads can land slightly out of order.
+    const uint64_t offset = event.timestamp_ns > origin_ns ? event.timestamp_ns - origin_ns : 0;
+    const double seconds = static_cast<double>(offset) / 1e9;
+    std::snprintf(line, sizeof(line), "%10.3f  %-12s %-4s %10s  %s\n", seconds,
+                  core::event_kind_name(event.kind), event.ok ? "ok" : "FAIL",
+                  core::metrics::format_duration(event.duration_ns).c_str(), event.name.c_str());
+    return line;
+}
+}  // namespace
+
+namespace ui {
+DiagnosticsPage::DiagnosticsPage(StatsProvider stats) : m_stats(std::move(stats)) {
+    m_root = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
+    m_root->set_spacing(12);
+    m_root->set_margin(20);
+
+    auto title = Gtk::make_managed<Gtk::Label>("Diagnostics");
+    title->set_halign(Gtk::Align::START);
+    title->add_css_class("section-title");
+    m_root->append(*title);
+
+    m_statsLabel = Gtk::make_managed<Gtk::Label>();
+    m_statsLabel->set_halign(Gtk::Align::START);
+    m_statsLabel->set_xalign(0.0f);
+    m_statsLabel->add_css_class("monospace");
+    m_root->append(*m_statsLabel);
+
+    m_buffer = Gtk::TextBuffer::create();
+    m_log = Gtk::make_managed<Gtk::TextView>(m_buffer);
+    m_log->set_editable(false);
+    m_log->set_cursor_visible(false);
+    m_log->set_monospace(true);
+
+    auto scroll = Gtk::make_managed<Gtk::ScrolledWindow>();
+    scroll->set_child(*m_log);
+    scroll->set_vexpand(true);
+    m_root->append(*scroll);
+
+    m_root->signal_map().connect(sigc::mem_fun(*this, &DiagnosticsPage::on_map));
+    m_root->signal_unmap().connect(sigc::mem_fun(*this, &DiagnosticsPage::on_unmap));
+}
+
+DiagnosticsPage::~DiagnosticsPage() {
+    m_refreshTimer.disconnect();
+}
+
+Gtk::Box* DiagnosticsPage::widget() const {
+    return m_root;
+}
+
+void DiagnosticsPage::refresh() {
+    std::string text;
+    if (m_stats) {
+        char line[128];
+        for (const auto& stat : m_stats()) {
+            std::snprintf(line, sizeof(line), "%-28s %zu\n", stat.first.c_str(), stat.second);
+            text += line;
+        }
+    }
+    if (!text.empty()) {
+        text.pop_back();
+    }
+    m_statsLabel->set_text(text);
+
+    append_events();
+}
+
+void DiagnosticsPage::append_events() {
+    const core::EventRing& ring = core::event_ring();
+    if (ring.head() == m_shownHead) {
+        return;
+    }
+
+    const auto events = ring.snapshot(m_shownHead);
+    m_shownHead = ring.head();
+    if (events.empty()) {
+        return;
+    }
+    if (!m_haveOrigin) {
+        m_originNs = events.front().timestamp_ns;
+        m_haveOrigin = true;
+    }
+
+    std::string text;
+    for (const auto& event : events) {
+        text += format_event(event, m_originNs);
+    }
+    m_buffer->insert(m_buffer->end(), text);
+
+    const int excess = m_buffer->get_line_count() - 1 - kMaxLogLines;
+    if (excess > 0) {
+        m_buffer->erase(m_buffer->begin(), m_buffer->get_iter_at_line(excess));
+    }
+    auto end = m_buffer->end();
+    m_log->scroll_to(end);
+}
+
+void DiagnosticsPage::on_map() {
+    refresh();
+    m_refreshTimer = Glib::signal_timeout().connect([this]() {
+        refresh();
+        return true;
+    }, kRefreshIntervalMs);
+}
+
+void DiagnosticsPage::on_unmap() {
+    m_refreshTimer.disconnect();
+}
+}  // namespace ui
@@ -0,0 +1,43 @@
+#ifndef UI_DIAGNOSTICS_PAGE_HPP
+#define UI_DIAGNOSTICS_PAGE_HPP
+
+#include <gtkmm.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ui {
+// Live view of core::event_ring() plus whatever counts the window reports.
+// Polls only while mapped, so a closed page costs nothing.
+class DiagnosticsPage {
+public:
+    using Stats = std::vector<std::pair<std::string, size_t>>;
+    using StatsProvider = std::function<Stats()>;
+
+    explicit DiagnosticsPage(StatsProvider stats);
+    ~DiagnosticsPage();
+
+    Gtk::Box* widget() const;
+    void refresh();
+
+private:
+    void on_map();
+    void on_unmap();
+    void append_events();
+
+    StatsProvider m_stats;
+    Gtk::Box* m_root = nullptr;
+    Gtk::Label* m_statsLabel = nullptr;
+    Gtk::TextView* m_log = nullptr;
+    Glib::RefPtr<Gtk::TextBuffer> m_buffer;
+    uint64_t m_shownHead = 0;
+    uint64_t m_originNs = 0;
+    bool m_haveOrigin = false;
+    sigc::connection m_refreshTimer;
+};
+}  // namespace ui
+
+#endif
@@ -0,0 +1,92 @@
+#include "ui/facet_bar.hpp"
+
+namespace ui {
+FacetBar::FacetBar(const std::function<void()>& on_changed) {
+    m_root = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL);
+    m_root->set_spacing(6);
+    m_root->set_margin_start(20);
+    m_root->set_margin_end(20);
+    m_root->set_margin_top(8);
+    m_root->add_css_class("facet-bar");
+
+    auto notify = [this, on_changed]() {
+        if (!m_updating) {
+            on_changed();
+        }
+    };
+
+    m_modified = Gtk::make_managed<Gtk::ToggleButton>("Set by user");
+    m_modified->set_tooltip_text("Only options set explicitly in the config");
+    m_modified->signal_toggled().connect(notify);
+    m_root->append(*m_modified);
+
+    m_nonDefault = Gtk::make_managed<Gtk::ToggleButton>("Non-default");
+    m_nonDefault->set_tooltip_text("Only options that differ from their default");
+    m_nonDefault->signal_toggled().connect(notify);
+    m_root->append(*m_nonDefault);
+
+    // Position i + 1 is Hyprland value type i.
+    m_type = Gtk::make_managed<Gtk::DropDown>();
+    m_type->set_model(Gtk::StringList::create({
+        "All types", "Boolean", "Integer", "Float", "Text", "Long text",
+        "Color", "Choice", "Gradient", "Vector",
+    }));
+    m_type->set_selected(0);
+    m_type->property_selected().signal_changed().connect(notify);
+    m_root->append(*m_type);
+
+    m_sectionModel = Gtk::StringList::create({"All sections"});
+    m_section = Gtk::make_managed<Gtk::DropDown>();
+    m_section->set_model(m_sectionModel);
+    m_section->set_selected(0);
+    m_section->property_selected().signal_changed().connect(notify);
+    m_root->append(*m_section);
+}
+
+Gtk::Box* FacetBar::widget() const {
+    return m_root;
+}
+
+void FacetBar::set_sections(const std::vector<std::string>& sections) {
+    const std::string current = section();
+
+    std::vector<Glib::ustring> labels;
+    labels.reserve(sections.size());
+    guint selected = 0;
+    for (guint i = 0; i < sections.size(); ++i) {
+        labels.emplace_back(sections[i]);
+        if (sections[i] == current) {
+            selected = i + 1;
+        }
+    }
+
+    m_updating = true;
+    m_sectionModel->splice(1, m_sectionModel->get_n_items() - 1, labels);
+    m_section->set_selected(selected);
+    m_updating = false;
+}
+
+bool FacetBar::modified_only() const {
+    return m_modified->get_active();
+}
+
+bool FacetBar::non_default_only() const {
+    return m_nonDefault->get_active();
+}
+
+int FacetBar::value_type() const {
+    const guint selected = m_type->get_selected();
+    if (selected == 0 || selected == GTK_INVALID_LIST_POSITION) {
+        return -1;
+    }
+    return static_cast<int>(selected) - 1;
+}
+
+std::string FacetBar::section() const {
+    const guint selected = m_section->get_selected();
+    if (selected == 0 || selected == GTK_INVALID_LIST_POSITION) {
+        return "";
+    }
+    return m_sectionModel->get_string(selected);
+}
+}  // namespace ui
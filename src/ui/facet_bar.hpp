@@ -0,0 +1,37 @@
+#ifndef UI_FACET_BAR_HPP
+#define UI_FACET_BAR_HPP
+
+#include <gtkmm.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ui {
+class FacetBar {
+public:
+    explicit FacetBar(const std::function<void()>& on_changed);
+
+    Gtk::Box* widget() const;
+
+    void set_sections(const std::vector<std::string>& sections);
+
+    bool modified_only() const;
+    bool non_default_only() const;
+    // Hyprland value type, or -1 for any.
+    int value_type() const;
+    // Top-level section, or empty for any.
+    std::string section() const;
+
+private:
+    Gtk::Box* m_root = nullptr;
+    Gtk::ToggleButton* m_modified = nullptr;
+    Gtk::ToggleButton* m_nonDefault = nullptr;
+    Gtk::DropDown* m_type = nullptr;
+    Gtk::DropDown* m_section = nullptr;
+    Glib::RefPtr<Gtk::StringList> m_sectionModel;
+    bool m_updating = false;
+};
+}  // namespace ui
+
+#endif
@@ -1,10 +1,15 @@
 #ifndef UI_ITEM_MODELS_HPP
 #define UI_ITEM_MODELS_HPP
 
+#include "core/choice_list.hpp"
+#include "core/models.hpp"
+#include "core/numeric_codec.hpp"
+#include "core/option_value.hpp"
+#include "core/value_codec.hpp"
+
 #include <gtkmm.h>
 
 #include <algorithm>
-#include <cctype>
 #include <cmath>
 #include <string>
 #include <utility>
@@ -15,13 +20,18 @@ class ConfigItem : public Glib::Object {
 public:
     std::string m_name;
     std::string m_short_name;
-    std::string m_value;
-    std::string m_lastAppliedValue;
+    core::OptionValue m_value;
+    core::OptionValue m_lastAppliedValue;
     std::string m_desc;
+    size_t m_optionIndex = 0;
     bool m_setByUser = false;
-    int m_valueType = -1;
-    bool m_hasChoices = false;
-    std::vector<std::pair<std::string, std::string>> m_choices;
+    // Whether the option has a default a reset can return to.
+    bool m_hasDefault = false;
+    core::ValueType m_valueType = core::ValueType::LongString;
+    std::string m_choicesCsv;
+
+    bool has_choices() { return m_valueType == core::ValueType::Choice && !choices().empty(); }
+    const core::ChoiceList& choices() { return load_choices(); }
 
     bool m_hasRange = false;
     double m_rangeMin = 0.0;
@@ -54,10 +64,14 @@ protected:
                bool hasVectorRange, double vectorMinX, double vectorMinY,
                double vectorMaxX, double vectorMaxY)
         : m_name(name),
-          m_value(value),
+          m_value(core::OptionValue::decode(valueType, value)),
           m_desc(desc),
           m_setByUser(setByUser),
-          m_valueType(valueType) {
+          m_valueType(core::value_type_from_id(valueType)) {
+        if (m_valueType == core::ValueType::Choice) {
+            m_choicesCsv = choiceValuesCsv;
+        }
+
         size_t pos = name.rfind(':');
         if (pos != std::string::npos) {
             m_short_name = name.substr(pos + 1);
@@ -65,75 +79,23 @@ protected:
             m_short_name = name;
         }
 
-        if (m_valueType == 0) {
-            m_value = (m_value == "true") ? "true" : "false";
-        }
-
-        auto trim = [](const std::string& s) -> std::string {
-            size_t start = 0;
-            while (start < s.size() && std::isspace(static_cast<unsigned char>(s[start])) != 0) {
-                ++start;
-            }
-
-            size_t end = s.size();
-            while (end > start && std::isspace(static_cast<unsigned char>(s[end - 1])) != 0) {
-                --end;
-            }
-
-            return s.substr(start, end - start);
-        };
-
-        if (m_valueType == 6) {
-            std::vector<std::pair<std::string, std::string>> parsedChoices;
-            size_t start = 0;
-            size_t index = 0;
-            while (start <= choiceValuesCsv.size()) {
-                const size_t end = choiceValuesCsv.find(',', start);
-                const std::string token = (end == std::string::npos)
-                    ? choiceValuesCsv.substr(start)
-                    : choiceValuesCsv.substr(start, end - start);
-                const std::string label = trim(token);
-                if (!label.empty()) {
-                    parsedChoices.emplace_back(std::to_string(index), label);
-                }
-                ++index;
-                if (end == std::string::npos) {
-                    break;
-                }
-                start = end + 1;
-            }
-
-            if (!parsedChoices.empty()) {
-                m_hasChoices = true;
-                m_choices = std::move(parsedChoices);
-            }
-        }
-
-        if (m_valueType == 6 && m_hasChoices) {
-            const auto matchesCurrentValue = [this](const std::pair<std::string, std::string>& choice) {
-                return choice.first == m_value;
-            };
-            if (std::find_if(m_choices.begin(), m_choices.end(), matchesCurrentValue) == m_choices.end()) {
-                m_value = "0";
-                if (!m_choices.empty()) {
-                    m_value = m_choices.front().first;
-                }
-            }
-        }
-
         m_hasRange = hasRange;
         if (m_hasRange) {
             m_rangeMin = rangeMin;
             m_rangeMax = rangeMax;
-            if (m_valueType == 2) {
+            if (m_valueType == core::ValueType::Float) {
                 m_isFloat = true;
-            } else if (m_valueType == 1) {
+            } else if (m_valueType == core::ValueType::Int) {
                 m_isFloat = false;
             } else {
                 const double minFrac = std::fabs(m_rangeMin - std::round(m_rangeMin));
                 const double maxFrac = std::fabs(m_rangeMax - std::round(m_rangeMax));
                 m_isFloat = minFrac > 0.0 || maxFrac > 0.0;
             }
+            const double current = m_value.is_numeric()
+                ? m_value.as_number()
+                : core::parse_number(m_value.str()).value_or(m_rangeMin);
+            m_value = core::OptionValue::from_number(current, m_isFloat);
         }
 
         m_hasVectorRange = hasVectorRange;
@@ -142,12 +104,50 @@ protected:
             m_vectorMinY = vectorMinY;
             m_vectorMaxX = vectorMaxX;
             m_vectorMaxY = vectorMaxY;
+            if (m_value.type() == core::ValueType::Vec2 && m_value.is_valid()) {
+                const auto vector = m_value.as_vec2();
+                const bool asFloat = core::has_fractional_component(m_vectorMinX) ||
+                                     core::has_fractional_component(m_vectorMinY) ||
+                                     core::has_fractional_component(m_vectorMaxX) ||
+                                     core::has_fractional_component(m_vectorMaxY);
+                m_value = core::OptionValue::from_vec2(std::clamp(vector.x, m_vectorMinX, m_vectorMaxX),
+                                                       std::clamp(vector.y, m_vectorMinY, m_vectorMaxY),
+                                                       asFloat);
+            }
         }
 
         m_lastAppliedValue = m_value;
     }
+
+private:
+    // Choice lists are parsed when a row first needs them. The current value
+    // is checked against the list at the same time and falls back to the first
+    // choice.
+    const core::ChoiceList& load_choices() {
+        if (!m_choiceList) {
+            m_choiceList = core::shared_choice_list(m_choicesCsv);
+            if (!m_choiceList->empty() && m_choiceList->find(m_value.str()) == core::ChoiceList::npos) {
+                m_value = core::OptionValue::decode(m_valueType, m_choiceList->entries().front().value);
+                m_lastAppliedValue = m_value;
+            }
+        }
+        return *m_choiceList;
+    }
+
+    std::shared_ptr<const core::ChoiceList> m_choiceList;
 };
 
+inline Glib::RefPtr<ConfigItem> make_config_item(const ConfigOptionData& option) {
+    return ConfigItem::create(option.name, option.value, option.description,
+                              option.set_by_user, option.value_type,
+                              option.choice_values_csv,
+                              option.has_range, option.range_min,
+                              option.range_max,
+                              option.has_vector_range,
+                              option.vector_min_x, option.vector_min_y,
+                              option.vector_max_x, option.vector_max_y);
+}
+
 class KeywordItem : public Glib::Object {
 public:
     std::string m_type;
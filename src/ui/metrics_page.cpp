@@ -0,0 +1,112 @@
+#include "ui/metrics_page.hpp"
+
+#include "core/metrics.hpp"
+
+#include <string>
+#include <utility>
+
+namespace {
+constexpr unsigned kRefreshIntervalMs = 1000;
+
+Gtk::Label* make_cell(Gtk::Grid& grid, int column, int row, const std::string& text, bool numeric) {
+    auto label = Gtk::make_managed<Gtk::Label>(text);
+    label->set_halign(numeric ? Gtk::Align::END : Gtk::Align::START);
+    if (numeric) {
+        label->add_css_class("numeric");
+    }
+    grid.attach(*label, column, row);
+    return label;
+}
+}  // namespace
+
+namespace ui {
+MetricsPage::MetricsPage() {
+    m_root = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
+    m_root->set_spacing(12);
+    m_root->set_margin(20);
+
+    auto title = Gtk::make_managed<Gtk::Label>("Backend Metrics");
+    title->set_halign(Gtk::Align::START);
+    title->add_css_class("section-title");
+    m_root->append(*title);
+
+    auto grid = Gtk::make_managed<Gtk::Grid>();
+    grid->set_column_spacing(24);
+    grid->set_row_spacing(6);
+    grid->add_css_class("metrics-grid");
+
+    const char* headers[] = {"Operation", "Count", "Failed", "p50", "p90", "p99", "Max"};
+    for (int column = 0; column < 7; ++column) {
+        make_cell(*grid, column, 0, headers[column], column > 0)->add_css_class("heading");
+    }
+
+    for (size_t i = 0; i < core::metrics::kOperationCount; ++i) {
+        const int row = static_cast<int>(i) + 1;
+        make_cell(*grid, 0, row, core::metrics::operation_name(static_cast<core::metrics::Operation>(i)), false);
+        std::vector<Gtk::Label*> cells;
+        for (int column = 1; column < 7; ++column) {
+            cells.push_back(make_cell(*grid, column, row, "", true));
+        }
+        m_operationCells.push_back(std::move(cells));
+    }
+
+    const int counterRow = static_cast<int>(core::metrics::kOperationCount) + 2;
+    for (size_t i = 0; i < core::metrics::kCounterCount; ++i) {
+        const int row = counterRow + static_cast<int>(i);
+        make_cell(*grid, 0, row, core::metrics::counter_name(static_cast<core::metrics::Counter>(i)), false);
+        m_counterCells.push_back(make_cell(*grid, 1, row, "", true));
+    }
+    m_root->append(*grid);
+
+    auto reset = Gtk::make_managed<Gtk::Button>("Reset");
+    reset->set_halign(Gtk::Align::START);
+    reset->signal_clicked().connect([this]() {
+        core::metrics::reset();
+        refresh();
+    });
+    m_root->append(*reset);
+
+    m_root->signal_map().connect(sigc::mem_fun(*this, &MetricsPage::on_map));
+    m_root->signal_unmap().connect(sigc::mem_fun(*this, &MetricsPage::on_unmap));
+}
+
+MetricsPage::~MetricsPage() {
+    m_refreshTimer.disconnect();
+}
+
+Gtk::Box* MetricsPage::widget() const {
+    return m_root;
+}
+
+void MetricsPage::refresh() {
+    using core::metrics::format_duration;
+
+    for (size_t i = 0; i < m_operationCells.size(); ++i) {
+        const auto operation = static_cast<core::metrics::Operation>(i);
+        const core::LatencyHistogram& histogram = core::metrics::latency(operation);
+        auto& cells = m_operationCells[i];
+        cells[0]->set_text(std::to_string(histogram.count()));
+        cells[1]->set_text(std::to_string(core::metrics::failures(operation)));
+        cells[2]->set_text(format_duration(histogram.quantile(0.50)));
+        cells[3]->set_text(format_duration(histogram.quantile(0.90)));
+        cells[4]->set_text(format_duration(histogram.quantile(0.99)));
+        cells[5]->set_text(format_duration(histogram.max()));
+    }
+    for (size_t i = 0; i < m_counterCells.size(); ++i) {
+        m_counterCells[i]->set_text(
+            std::to_string(core::metrics::counter(static_cast<core::metrics::Counter>(i))));
+    }
+}
+
+void MetricsPage::on_map() {
+    refresh();
+    m_refreshTimer = Glib::signal_timeout().connect([this]() {
+        refresh();
+        return true;
+    }, kRefreshIntervalMs);
+}
+
+void MetricsPage::on_unmap() {
+    m_refreshTimer.disconnect();
+}
+}  // namespace ui
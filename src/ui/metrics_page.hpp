@@ -0,0 +1,31 @@
+#ifndef UI_METRICS_PAGE_HPP
+#define UI_METRICS_PAGE_HPP
+
+#include <gtkmm.h>
+
+#include <vector>
+
+namespace ui {
+// Debug page with the backend latency percentiles and counters from
+// core::metrics. Refreshes itself only while it is mapped.
+class MetricsPage {
+public:
+    MetricsPage();
+    ~MetricsPage();
+
+    Gtk::Box* widget() const;
+    void refresh();
+
+private:
+    void on_map();
+    void on_unmap();
+
+    Gtk::Box* m_root = nullptr;
+    // One row of value labels per operation, then one label per counter.
+    std::vector<std::vector<Gtk::Label*>> m_operationCells;
+    std::vector<Gtk::Label*> m_counterCells;
+    sigc::connection m_refreshTimer;
+};
+}  // namespace ui
+
+#endif
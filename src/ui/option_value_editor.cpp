@@ -1,180 +1,42 @@
 #include "ui/option_value_editor.hpp"
 
+#include "core/numeric_codec.hpp"
+#include "core/value_codec.hpp"
+
 #include <algorithm>
-#include <cctype>
-#include <cmath>
-#include <exception>
-#include <iomanip>
-#include <optional>
-#include <sstream>
+#include <unordered_map>
 
 namespace {
-std::string trim_copy(const std::string& value) {
-    size_t start = 0;
-    while (start < value.size() && std::isspace(static_cast<unsigned char>(value[start])) != 0) {
-        ++start;
-    }
-
-    size_t end = value.size();
-    while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1])) != 0) {
-        --end;
-    }
-
-    return value.substr(start, end - start);
-}
-
-std::string collapse_whitespace(const std::string& value) {
-    std::string out;
-    out.reserve(value.size());
-    bool previous_was_space = false;
-    for (char c : value) {
-        if (std::isspace(static_cast<unsigned char>(c)) != 0) {
-            if (!previous_was_space) {
-                out.push_back(' ');
-                previous_was_space = true;
-            }
-        } else {
-            out.push_back(c);
-            previous_was_space = false;
-        }
-    }
-    return trim_copy(out);
-}
-
-bool is_digits_only(const std::string& value) {
-    return !value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char c) {
-        return std::isdigit(c) != 0;
-    });
-}
-
-bool is_hex_digits_only(const std::string& value) {
-    return !value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char c) {
-        return std::isxdigit(c) != 0;
-    });
-}
-
-std::string to_lower_ascii(const std::string& value) {
-    std::string out = value;
-    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) {
-        return static_cast<char>(std::tolower(c));
-    });
-    return out;
-}
-
-std::optional<double> parse_double_strict(const std::string& value) {
-    const std::string trimmed = trim_copy(value);
-    if (trimmed.empty()) {
-        return std::nullopt;
+// One model per shared choice list, reused by every dropdown that shows it and
+// kept across refreshes, so binding a choice row never builds a new list.
+// Choice lists live for the whole process, so their address is a stable key.
+Glib::RefPtr<Gtk::StringList> shared_choice_model(const core::ChoiceList& choices) {
+    static std::unordered_map<const core::ChoiceList*, Glib::RefPtr<Gtk::StringList>> models;
+
+    auto it = models.find(&choices);
+    if (it != models.end()) {
+        return it->second;
     }
 
-    try {
-        size_t consumed = 0;
-        double parsed = std::stod(trimmed, &consumed);
-        if (consumed != trimmed.size()) {
-            return std::nullopt;
-        }
-        return parsed;
-    } catch (const std::exception&) {
-        return std::nullopt;
+    std::vector<Glib::ustring> labels;
+    labels.reserve(choices.size());
+    for (const auto& choice : choices.entries()) {
+        labels.emplace_back(choice.label);
     }
-}
 
-std::optional<long long> parse_int_truncate(const std::string& value) {
-    try {
-        double parsed = std::stod(value);
-        return static_cast<long long>(std::trunc(parsed));
-    } catch (const std::exception&) {
-        return std::nullopt;
-    }
+    auto model = Gtk::StringList::create(labels);
+    models.emplace(&choices, model);
+    return model;
 }
 
-std::string format_range_value(double val, bool is_float) {
-    if (!is_float) {
-        return std::to_string(static_cast<long long>(std::trunc(val)));
-    }
-
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(2) << val;
-    std::string valStr = ss.str();
-    if (!valStr.empty()) {
-        valStr.erase(valStr.find_last_not_of('0') + 1, std::string::npos);
-        if (!valStr.empty() && valStr.back() == '.') {
-            valStr.pop_back();
-        }
+// The row only takes the value as applied when the window says it was sent;
+// a staged edit keeps the last applied value for Discard. The window skips
+// values it already has, so this can be called on every commit gesture.
+void submit_edit(ui::ConfigItem& item, const ui::OptionUpdateCallback& send_update) {
+    if (send_update(item.m_name, item.m_value)) {
+        item.m_lastAppliedValue = item.m_value;
+        item.m_setByUser = true;
     }
-    return valStr;
-}
-
-std::optional<std::string> normalize_color_value(const std::string& input) {
-    std::string value = trim_copy(input);
-    if (value.empty()) {
-        return std::string();
-    }
-
-    if (is_digits_only(value)) {
-        return value;
-    }
-
-    if (value.size() > 2 && (value[0] == '0') && (value[1] == 'x' || value[1] == 'X')) {
-        const std::string hex_part = value.substr(2);
-        if (!is_hex_digits_only(hex_part)) {
-            return std::nullopt;
-        }
-        return std::string("0x") + to_lower_ascii(hex_part);
-    }
-
-    if (!value.empty() && value[0] == '#') {
-        const std::string hex_part = value.substr(1);
-        if ((hex_part.size() != 6 && hex_part.size() != 8) || !is_hex_digits_only(hex_part)) {
-            return std::nullopt;
-        }
-        return std::string("0x") + to_lower_ascii(hex_part);
-    }
-
-    if ((value.size() == 6 || value.size() == 8) && is_hex_digits_only(value)) {
-        return std::string("0x") + to_lower_ascii(value);
-    }
-
-    return std::nullopt;
-}
-
-std::optional<std::string> normalize_gradient_value(const std::string& input) {
-    std::string value = collapse_whitespace(input);
-    if (value.empty()) {
-        return std::nullopt;
-    }
-    return value;
-}
-
-bool has_fractional_component(double value) {
-    return std::fabs(value - std::round(value)) > 0.000001;
-}
-
-std::optional<std::pair<double, double>> parse_vector_value(const std::string& input) {
-    std::string value = input;
-    std::replace(value.begin(), value.end(), ',', ' ');
-
-    std::stringstream ss(value);
-    double x = 0.0;
-    double y = 0.0;
-    if (!(ss >> x >> y)) {
-        return std::nullopt;
-    }
-
-    std::string tail;
-    if (ss >> tail) {
-        return std::nullopt;
-    }
-
-    return std::make_pair(x, y);
-}
-
-std::string format_scalar(double value, bool as_float) {
-    return format_range_value(value, as_float || has_fractional_component(value));
-}
-
-std::string format_vector_value(double x, double y, bool as_float) {
-    return format_scalar(x, as_float) + ", " + format_scalar(y, as_float);
 }
 }
 
@@ -183,8 +45,9 @@ void setup_option_value_editor(
     const Glib::RefPtr<Gtk::ListItem>& list_item,
     Gtk::ScrolledWindow& content_scroll,
     bool& binding_programmatically,
-    const std::function<void(const std::string&, const std::string&)>& send_update,
-    const std::function<void(const std::string&, const std::string&)>& send_runtime_update) {
+    const OptionUpdateCallback& send_update,
+    const std::function<void(const std::string&, const core::OptionValue&)>& send_runtime_update,
+    const std::function<void(size_t)>& reset_option) {
     auto container = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL);
     container->set_spacing(10);
 
@@ -258,18 +121,29 @@ void setup_option_value_editor(
     rangeBox->append(*slider);
 
     container->append(*rangeBox);
+
+    auto resetButton = Gtk::make_managed<Gtk::Button>();
+    resetButton->set_icon_name("document-revert-symbolic");
+    resetButton->set_tooltip_text("Reset to default");
+    resetButton->set_valign(Gtk::Align::CENTER);
+    resetButton->add_css_class("flat");
+    resetButton->add_css_class("row-reset");
+    container->append(*resetButton);
     list_item->set_child(*container);
 
+    resetButton->signal_clicked().connect([list_item, reset_option]() {
+        auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
+        if (item && item->m_hasDefault) {
+            reset_option(item->m_optionIndex);
+        }
+    });
+
     boolButton->signal_clicked().connect([boolButton, list_item, send_update]() {
         auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
-        if (item && item->m_valueType == 0) {
-            const bool nextValue = (item->m_value != "true");
-            item->m_value = nextValue ? "true" : "false";
-            boolButton->set_label(item->m_value);
-            if (item->m_value != item->m_lastAppliedValue) {
-                send_update(item->m_name, item->m_value);
-                item->m_lastAppliedValue = item->m_value;
-            }
+        if (item && item->m_valueType == core::ValueType::Bool) {
+            item->m_value = core::OptionValue::from_bool(!item->m_value.as_bool());
+            boolButton->set_label(item->m_value.str());
+            submit_edit(*item, send_update);
         }
     });
 
@@ -277,18 +151,16 @@ void setup_option_value_editor(
         if (binding_programmatically) return;
 
         auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
-        if (!item || !item->m_hasChoices) return;
+        if (!item || !item->has_choices()) return;
 
+        const auto& choices = item->choices();
         auto selected = choiceDropDown->get_selected();
-        if (selected == GTK_INVALID_LIST_POSITION || selected >= item->m_choices.size()) return;
+        if (selected == GTK_INVALID_LIST_POSITION || selected >= choices.size()) return;
 
-        const std::string newValue = item->m_choices[selected].first;
+        const auto newValue = core::OptionValue::decode(item->m_valueType, choices[selected].value);
         if (newValue != item->m_value) {
             item->m_value = newValue;
-            if (item->m_value != item->m_lastAppliedValue) {
-                send_update(item->m_name, item->m_value);
-                item->m_lastAppliedValue = item->m_value;
-            }
+            submit_edit(*item, send_update);
         }
     });
 
@@ -298,97 +170,33 @@ void setup_option_value_editor(
         }
 
         auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
-        if (!item || item->m_hasRange || item->m_valueType == 0 || item->m_hasChoices) {
+        if (!item || item->m_hasRange || item->m_valueType == core::ValueType::Bool || item->has_choices()) {
             return;
         }
 
-        std::string newVal = label->get_text();
-        switch (item->m_valueType) {
-        case 1: {
-            auto truncated = parse_int_truncate(newVal);
-            if (!truncated.has_value()) {
-                label->set_text(item->m_value);
-                return;
-            }
-            newVal = std::to_string(*truncated);
-            label->set_text(newVal);
-            break;
-        }
-        case 2: {
-            auto parsed = parse_double_strict(newVal);
-            if (!parsed.has_value()) {
-                label->set_text(item->m_value);
-                return;
-            }
-            newVal = format_scalar(*parsed, true);
-            label->set_text(newVal);
-            break;
-        }
-        case 3: {
-            newVal = collapse_whitespace(newVal);
-            label->set_text(newVal);
-            break;
-        }
-        case 4: {
-            if (newVal == "[[EMPTY]]") {
-                newVal.clear();
-                label->set_text(newVal);
-            }
-            break;
-        }
-        case 5: {
-            auto normalized = normalize_color_value(newVal);
-            if (!normalized.has_value()) {
-                label->set_text(item->m_value);
-                return;
-            }
-            newVal = *normalized;
-            label->set_text(newVal);
-            break;
-        }
-        case 7: {
-            auto normalized = normalize_gradient_value(newVal);
-            if (!normalized.has_value()) {
-                label->set_text(item->m_value);
-                return;
-            }
-            newVal = *normalized;
-            label->set_text(newVal);
-            break;
+        auto newValue = core::OptionValue::decode(item->m_valueType, label->get_text().raw());
+        if (!newValue.is_valid()) {
+            label->set_text(item->m_value.str());
+            return;
         }
-        case 8: {
-            auto vector = parse_vector_value(newVal);
-            if (!vector.has_value()) {
-                label->set_text(item->m_value);
-                return;
-            }
 
-            double x = vector->first;
-            double y = vector->second;
-            if (item->m_hasVectorRange) {
-                x = std::clamp(x, item->m_vectorMinX, item->m_vectorMaxX);
-                y = std::clamp(y, item->m_vectorMinY, item->m_vectorMaxY);
-            }
-
-            const bool as_float = has_fractional_component(x) || has_fractional_component(y) ||
-                                  has_fractional_component(item->m_vectorMinX) ||
-                                  has_fractional_component(item->m_vectorMinY) ||
-                                  has_fractional_component(item->m_vectorMaxX) ||
-                                  has_fractional_component(item->m_vectorMaxY);
-            newVal = format_vector_value(x, y, as_float);
-            label->set_text(newVal);
-            break;
-        }
-        default:
-            break;
+        if (newValue.type() == core::ValueType::Float) {
+            newValue = core::OptionValue::from_number(newValue.as_number(), true);
+        } else if (newValue.type() == core::ValueType::Vec2 && item->m_hasVectorRange) {
+            const auto vector = newValue.as_vec2();
+            const bool asFloat = core::has_fractional_component(item->m_vectorMinX) ||
+                                 core::has_fractional_component(item->m_vectorMinY) ||
+                                 core::has_fractional_component(item->m_vectorMaxX) ||
+                                 core::has_fractional_component(item->m_vectorMaxY);
+            newValue = core::OptionValue::from_vec2(std::clamp(vector.x, item->m_vectorMinX, item->m_vectorMaxX),
+                                                    std::clamp(vector.y, item->m_vectorMinY, item->m_vectorMaxY),
+                                                    asFloat);
         }
+        label->set_text(newValue.str());
 
-        if (newVal != item->m_value) {
-            item->m_value = newVal;
-            if (item->m_value != item->m_lastAppliedValue) {
-                send_update(item->m_name, item->m_value);
-                item->m_lastAppliedValue = item->m_value;
-            }
+        if (newValue != item->m_value) {
+            item->m_value = newValue;
+            submit_edit(*item, send_update);
         }
     });
 
@@ -397,11 +205,11 @@ void setup_option_value_editor(
 
         auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
         if (item && item->m_hasRange) {
-            const std::string valStr = format_range_value(slider->get_value(), item->m_isFloat);
-            if (valStr != item->m_value) {
-                entry->set_text(valStr);
-                item->m_value = valStr;
-                send_runtime_update(item->m_name, valStr);
+            const auto newValue = core::OptionValue::from_number(slider->get_value(), item->m_isFloat);
+            if (newValue.str() != item->m_value.str()) {
+                entry->set_text(newValue.str());
+                item->m_value = newValue;
+                send_runtime_update(item->m_name, item->m_value);
             }
         }
     });
@@ -409,9 +217,8 @@ void setup_option_value_editor(
     auto dragGesture = Gtk::GestureDrag::create();
     dragGesture->signal_drag_end().connect([list_item, send_update](double, double) {
         auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
-        if (item && item->m_hasRange && item->m_value != item->m_lastAppliedValue) {
-            send_update(item->m_name, item->m_value);
-            item->m_lastAppliedValue = item->m_value;
+        if (item && item->m_hasRange) {
+            submit_edit(*item, send_update);
         }
     });
     slider->add_controller(dragGesture);
@@ -419,9 +226,8 @@ void setup_option_value_editor(
     auto clickGesture = Gtk::GestureClick::create();
     clickGesture->signal_released().connect([list_item, send_update](int, double, double) {
         auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
-        if (item && item->m_hasRange && item->m_value != item->m_lastAppliedValue) {
-            send_update(item->m_name, item->m_value);
-            item->m_lastAppliedValue = item->m_value;
+        if (item && item->m_hasRange) {
+            submit_edit(*item, send_update);
         }
     });
     slider->add_controller(clickGesture);
@@ -429,31 +235,29 @@ void setup_option_value_editor(
     entry->signal_activate().connect([slider, entry, list_item, send_update]() {
         auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
         if (item && item->m_hasRange) {
-            try {
-                double val = std::stod(entry->get_text());
-                if (val < item->m_rangeMin) val = item->m_rangeMin;
-                if (val > item->m_rangeMax) val = item->m_rangeMax;
-
-                slider->set_value(val);
-                if (slider->get_value() == val) {
-                    const std::string valStr = format_range_value(val, item->m_isFloat);
-                    if (valStr != item->m_value) {
-                        item->m_value = valStr;
-                        if (item->m_value != item->m_lastAppliedValue) {
-                            send_update(item->m_name, item->m_value);
-                            item->m_lastAppliedValue = item->m_value;
-                        }
-                    }
-                    entry->set_text(valStr);
+            auto parsed = core::parse_number(entry->get_text().raw());
+            if (!parsed.has_value()) {
+                entry->set_text(item->m_value.str());
+                return;
+            }
+
+            const double val = std::clamp(*parsed, item->m_rangeMin, item->m_rangeMax);
+            slider->set_value(val);
+            if (slider->get_value() == val) {
+                const auto newValue = core::OptionValue::from_number(val, item->m_isFloat);
+                if (newValue != item->m_value) {
+                    item->m_value = newValue;
+                    submit_edit(*item, send_update);
                 }
-            } catch (const std::exception&) {
-                entry->set_text(item->m_value);
+                entry->set_text(newValue.str());
             }
         }
     });
 
 }
 
+// Values are canonicalised when the item is created, so binding only copies
+// the decoded value into the widgets.
 void bind_option_value_editor(const Glib::RefPtr<Gtk::ListItem>& list_item,
                               bool& binding_programmatically) {
     auto item = std::dynamic_pointer_cast<ConfigItem>(list_item->get_item());
@@ -468,31 +272,32 @@ void bind_option_value_editor(const Glib::RefPtr<Gtk::ListItem>& list_item,
     if (!label) return;
     auto rangeBox = dynamic_cast<Gtk::Box*>(label->get_next_sibling());
     if (!rangeBox) return;
+    auto resetButton = dynamic_cast<Gtk::Button*>(rangeBox->get_next_sibling());
+    if (!resetButton) return;
+
+    resetButton->set_visible(item->m_hasDefault);
 
-    if (item->m_valueType == 0) {
+    if (item->m_valueType == core::ValueType::Bool) {
         boolButton->set_visible(true);
         choiceDropDown->set_visible(false);
         label->set_visible(false);
         rangeBox->set_visible(false);
 
-        item->m_value = (item->m_value == "true") ? "true" : "false";
-        boolButton->set_label(item->m_value);
-    } else if (item->m_hasChoices) {
+        boolButton->set_label(item->m_value.str());
+    } else if (item->has_choices()) {
         boolButton->set_visible(false);
         choiceDropDown->set_visible(true);
         label->set_visible(false);
         rangeBox->set_visible(false);
 
-        auto model = Gtk::StringList::create({});
-        guint selected = 0;
-        for (guint i = 0; i < item->m_choices.size(); ++i) {
-            model->append(item->m_choices[i].second);
-            if (item->m_choices[i].first == item->m_value) {
-                selected = i;
-            }
-        }
+        const auto& choices = item->choices();
+        auto model = shared_choice_model(choices);
+        const size_t index = choices.find(item->m_value.str());
+        const guint selected = index == core::ChoiceList::npos ? 0 : static_cast<guint>(index);
         binding_programmatically = true;
-        choiceDropDown->set_model(model);
+        if (std::dynamic_pointer_cast<Gtk::StringList>(choiceDropDown->get_model()) != model) {
+            choiceDropDown->set_model(model);
+        }
         choiceDropDown->set_selected(selected);
         binding_programmatically = false;
     } else if (item->m_hasRange) {
@@ -517,20 +322,8 @@ void bind_option_value_editor(const Glib::RefPtr<Gtk::ListItem>& list_item,
         }
 
         binding_programmatically = true;
-        try {
-            double val = std::stod(item->m_value);
-            slider->set_value(val);
-            const std::string formatted = format_range_value(val, item->m_isFloat);
-            entry->set_text(formatted);
-            item->m_value = formatted;
-            item->m_lastAppliedValue = formatted;
-        } catch (const std::exception&) {
-            slider->set_value(item->m_rangeMin);
-            const std::string formatted = format_range_value(item->m_rangeMin, item->m_isFloat);
-            entry->set_text(formatted);
-            item->m_value = formatted;
-            item->m_lastAppliedValue = formatted;
-        }
+        slider->set_value(item->m_value.as_number(item->m_rangeMin));
+        entry->set_text(item->m_value.str());
         binding_programmatically = false;
     } else {
         boolButton->set_visible(false);
@@ -538,45 +331,7 @@ void bind_option_value_editor(const Glib::RefPtr<Gtk::ListItem>& list_item,
         label->set_visible(true);
         rangeBox->set_visible(false);
 
-        std::string displayValue = item->m_value;
-        if (item->m_valueType == 3 || item->m_valueType == 4) {
-            if (displayValue == "[[EMPTY]]") {
-                displayValue.clear();
-                item->m_value.clear();
-            }
-        } else if (item->m_valueType == 5) {
-            auto normalized = normalize_color_value(displayValue);
-            if (normalized.has_value()) {
-                displayValue = *normalized;
-                item->m_value = displayValue;
-            }
-        } else if (item->m_valueType == 7) {
-            auto normalized = normalize_gradient_value(displayValue);
-            if (normalized.has_value()) {
-                displayValue = *normalized;
-                item->m_value = displayValue;
-            }
-        } else if (item->m_valueType == 8) {
-            auto vector = parse_vector_value(displayValue);
-            if (vector.has_value()) {
-                double x = vector->first;
-                double y = vector->second;
-                if (item->m_hasVectorRange) {
-                    x = std::clamp(x, item->m_vectorMinX, item->m_vectorMaxX);
-                    y = std::clamp(y, item->m_vectorMinY, item->m_vectorMaxY);
-                }
-
-                const bool as_float = has_fractional_component(x) || has_fractional_component(y) ||
-                                      has_fractional_component(item->m_vectorMinX) ||
-                                      has_fractional_component(item->m_vectorMinY) ||
-                                      has_fractional_component(item->m_vectorMaxX) ||
-                                      has_fractional_component(item->m_vectorMaxY);
-                displayValue = format_vector_value(x, y, as_float);
-                item->m_value = displayValue;
-            }
-        }
-
-        label->set_text(displayValue);
+        label->set_text(item->m_value.str());
     }
 }
 }  // namespace ui
@@ -1,20 +1,26 @@
 #ifndef UI_OPTION_VALUE_EDITOR_HPP
 #define UI_OPTION_VALUE_EDITOR_HPP
 
+#include "core/option_value.hpp"
 #include "ui/item_models.hpp"
 
 #include <gtkmm.h>
 
+#include <cstddef>
 #include <functional>
 #include <string>
 
 namespace ui {
+// Returns true when the value was applied, false when it was only staged.
+using OptionUpdateCallback = std::function<bool(const std::string&, const core::OptionValue&)>;
+
 void setup_option_value_editor(
     const Glib::RefPtr<Gtk::ListItem>& list_item,
     Gtk::ScrolledWindow& content_scroll,
     bool& binding_programmatically,
-    const std::function<void(const std::string&, const std::string&)>& send_update,
-    const std::function<void(const std::string&, const std::string&)>& send_runtime_update);
+    const OptionUpdateCallback& send_update,
+    const std::function<void(const std::string&, const core::OptionValue&)>& send_runtime_update,
+    const std::function<void(size_t)>& reset_option);
 
 void bind_option_value_editor(const Glib::RefPtr<Gtk::ListItem>& list_item,
                               bool& binding_programmatically);
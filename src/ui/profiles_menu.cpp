@@ -0,0 +1,106 @@
+#include "ui/profiles_menu.hpp"
+
+namespace ui {
+ProfilesMenu::ProfilesMenu(const std::function<std::vector<std::string>()>& list_profiles,
+                           const std::function<void(const std::string&)>& on_apply,
+                           const std::function<void(const std::string&)>& on_save,
+                           const std::function<void(const std::string&)>& on_remove,
+                           const std::function<void()>& on_reset_all)
+    : m_listProfiles(list_profiles), m_onApply(on_apply), m_onRemove(on_remove) {
+    m_button = Gtk::make_managed<Gtk::MenuButton>();
+    m_button->set_icon_name("document-open-recent-symbolic");
+    m_button->set_tooltip_text("Profiles");
+
+    auto content = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
+    content->set_spacing(8);
+    content->set_margin(6);
+
+    m_list = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
+    m_list->set_spacing(2);
+    content->append(*m_list);
+    content->append(*Gtk::make_managed<Gtk::Separator>(Gtk::Orientation::HORIZONTAL));
+
+    auto saveBox = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL);
+    saveBox->set_spacing(5);
+    auto nameEntry = Gtk::make_managed<Gtk::Entry>();
+    nameEntry->set_placeholder_text("New profile name...");
+    nameEntry->set_hexpand(true);
+    auto saveButton = Gtk::make_managed<Gtk::Button>("Save");
+    saveButton->set_tooltip_text("Save the current options as a profile");
+
+    auto save = [this, on_save, nameEntry]() {
+        const std::string name = nameEntry->get_text();
+        if (name.empty()) {
+            return;
+        }
+        on_save(name);
+        nameEntry->set_text("");
+        refresh();
+    };
+    saveButton->signal_clicked().connect(save);
+    nameEntry->signal_activate().connect(save);
+    saveBox->append(*nameEntry);
+    saveBox->append(*saveButton);
+    content->append(*saveBox);
+
+    auto resetButton = Gtk::make_managed<Gtk::Button>("Reset All to Defaults");
+    resetButton->add_css_class("destructive-action");
+    resetButton->set_tooltip_text("Put every option back to Hyprland's default");
+    resetButton->signal_clicked().connect([this, on_reset_all]() {
+        m_popover->popdown();
+        on_reset_all();
+    });
+    content->append(*resetButton);
+
+    m_popover = Gtk::make_managed<Gtk::Popover>();
+    m_popover->set_child(*content);
+    m_popover->signal_show().connect(sigc::mem_fun(*this, &ProfilesMenu::refresh));
+    m_button->set_popover(*m_popover);
+}
+
+Gtk::MenuButton* ProfilesMenu::widget() const {
+    return m_button;
+}
+
+void ProfilesMenu::refresh() {
+    while (auto child = m_list->get_first_child()) {
+        m_list->remove(*child);
+    }
+
+    const std::vector<std::string> names = m_listProfiles();
+    if (names.empty()) {
+        auto empty = Gtk::make_managed<Gtk::Label>("No saved profiles");
+        empty->add_css_class("dim-label");
+        m_list->append(*empty);
+        return;
+    }
+
+    for (const auto& name : names) {
+        auto row = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL);
+        row->set_spacing(5);
+
+        auto applyButton = Gtk::make_managed<Gtk::Button>(name);
+        applyButton->set_hexpand(true);
+        applyButton->add_css_class("flat");
+        applyButton->set_tooltip_text("Switch to this profile");
+        applyButton->signal_clicked().connect([this, name]() {
+            m_popover->popdown();
+            m_onApply(name);
+        });
+
+        auto removeButton = Gtk::make_managed<Gtk::Button>();
+        removeButton->set_icon_name("user-trash-symbolic");
+        removeButton->add_css_class("flat");
+        removeButton->set_tooltip_text("Delete this profile");
+        removeButton->signal_clicked().connect([this, name]() {
+            m_onRemove(name);
+            // Rebuilding the list here would destroy this button mid-signal.
+            Glib::signal_idle().connect_once([this]() { refresh(); });
+        });
+
+        row->append(*applyButton);
+        row->append(*removeButton);
+        m_list->append(*row);
+    }
+}
+}  // namespace ui
@@ -0,0 +1,35 @@
+#ifndef UI_PROFILES_MENU_HPP
+#define UI_PROFILES_MENU_HPP
+
+#include <gtkmm.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ui {
+// Header-bar menu listing the saved profiles, with a field to save the
+// current options under a new name, and a way back to the defaults.
+class ProfilesMenu {
+public:
+    ProfilesMenu(const std::function<std::vector<std::string>()>& list_profiles,
+                 const std::function<void(const std::string&)>& on_apply,
+                 const std::function<void(const std::string&)>& on_save,
+                 const std::function<void(const std::string&)>& on_remove,
+                 const std::function<void()>& on_reset_all);
+
+    Gtk::MenuButton* widget() const;
+    // Re-reads the profile list; also done each time the menu opens.
+    void refresh();
+
+private:
+    std::function<std::vector<std::string>()> m_listProfiles;
+    std::function<void(const std::string&)> m_onApply;
+    std::function<void(const std::string&)> m_onRemove;
+    Gtk::MenuButton* m_button = nullptr;
+    Gtk::Popover* m_popover = nullptr;
+    Gtk::Box* m_list = nullptr;
+};
+}  // namespace ui
+
+#endif
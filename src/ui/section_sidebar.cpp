@@ -0,0 +1,168 @@
+#include "ui/section_sidebar.hpp"
+
+#include <vector>
+
+namespace {
+Glib::RefPtr<Gio::ListStore<ui::SectionRow>> rows_for_children(const core::SectionNode& node) {
+    std::vector<Glib::RefPtr<ui::SectionRow>> rows;
+    rows.reserve(node.children.size());
+    for (const auto& child : node.children) {
+        rows.push_back(ui::SectionRow::create(child.get()));
+    }
+
+    auto store = Gio::ListStore<ui::SectionRow>::create();
+    store->splice(0, 0, rows);
+    return store;
+}
+}
+
+namespace ui {
+SectionSidebar::SectionSidebar(const std::function<void(const std::string&)>& on_section_selected,
+                               const std::function<void(const std::string&)>& on_section_reset) {
+    m_view = Gtk::make_managed<Gtk::ListView>();
+    m_view->add_css_class("sidebar");
+
+    auto factory = Gtk::SignalListItemFactory::create();
+    factory->signal_setup().connect([on_section_reset](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+        auto box = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL);
+        box->set_spacing(6);
+
+        auto name = Gtk::make_managed<Gtk::Label>();
+        name->set_halign(Gtk::Align::START);
+        name->set_hexpand(true);
+        name->set_ellipsize(Pango::EllipsizeMode::END);
+        box->append(*name);
+
+        auto count = Gtk::make_managed<Gtk::Label>();
+        count->add_css_class("section-count");
+        box->append(*count);
+
+        auto reset = Gtk::make_managed<Gtk::Button>();
+        reset->set_icon_name("document-revert-symbolic");
+        reset->set_tooltip_text("Reset section to defaults");
+        reset->add_css_class("flat");
+        reset->add_css_class("row-reset");
+        reset->signal_clicked().connect([list_item, on_section_reset]() {
+            auto row = std::dynamic_pointer_cast<Gtk::TreeListRow>(list_item->get_item());
+            auto section = row ? std::dynamic_pointer_cast<SectionRow>(row->get_item()) : nullptr;
+            if (section && section->m_node) {
+                on_section_reset(section->m_node->full_path);
+            }
+        });
+        box->append(*reset);
+
+        auto expander = Gtk::make_managed<Gtk::TreeExpander>();
+        expander->set_child(*box);
+        list_item->set_child(*expander);
+    });
+    factory->signal_bind().connect([](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+        auto row = std::dynamic_pointer_cast<Gtk::TreeListRow>(list_item->get_item());
+        auto expander = dynamic_cast<Gtk::TreeExpander*>(list_item->get_child());
+        if (!row || !expander) return;
+
+        expander->set_list_row(row);
+        auto section = std::dynamic_pointer_cast<SectionRow>(row->get_item());
+        auto box = dynamic_cast<Gtk::Box*>(expander->get_child());
+        if (!section || !section->m_node || !box) return;
+
+        auto name = dynamic_cast<Gtk::Label*>(box->get_first_child());
+        auto count = name ? dynamic_cast<Gtk::Label*>(name->get_next_sibling()) : nullptr;
+        if (!name || !count) return;
+
+        name->set_text(section->m_node->name);
+        count->set_visible(section->m_node->option_count > 0);
+        count->set_text(std::to_string(section->m_node->option_count));
+    });
+    factory->signal_unbind().connect([](const Glib::RefPtr<Gtk::ListItem>& list_item) {
+        auto expander = dynamic_cast<Gtk::TreeExpander*>(list_item->get_child());
+        if (expander) {
+            expander->set_list_row({});
+        }
+    });
+    m_view->set_factory(factory);
+
+    m_selection = Gtk::SingleSelection::create();
+    m_selection->set_autoselect(false);
+    m_selection->set_can_unselect(true);
+    m_selection->property_selected().signal_changed().connect([this, on_section_selected]() {
+        auto row = std::dynamic_pointer_cast<Gtk::TreeListRow>(m_selection->get_selected_item());
+        auto section = row ? std::dynamic_pointer_cast<SectionRow>(row->get_item()) : nullptr;
+        if (section && section->m_node) {
+            on_section_selected(section->m_node->full_path);
+        }
+    });
+    m_view->set_model(m_selection);
+
+    set_tree(nullptr);
+}
+
+Gtk::ListView* SectionSidebar::widget() const {
+    return m_view;
+}
+
+void SectionSidebar::set_tree(const core::SectionTree* tree) {
+    m_tree = tree;
+    Glib::RefPtr<Gio::ListModel> top_level = tree
+        ? Glib::RefPtr<Gio::ListModel>(rows_for_children(tree->root()))
+        : Glib::RefPtr<Gio::ListModel>(Gio::ListStore<SectionRow>::create());
+
+    m_model = Gtk::TreeListModel::create(
+        top_level,
+        sigc::mem_fun(*this, &SectionSidebar::create_child_model),
+        false,
+        false);
+    m_selection->set_model(m_model);
+}
+
+void SectionSidebar::expand(const std::string& full_path) {
+    if (!m_tree) return;
+
+    auto row = row_for(m_tree->find(full_path));
+    if (row) {
+        row->set_expanded(true);
+    }
+}
+
+void SectionSidebar::select(const std::string& full_path) {
+    if (!m_tree) return;
+
+    auto row = row_for(m_tree->find(full_path));
+    if (!row) return;
+
+    const guint position = row->get_position();
+    if (m_selection->get_selected() != position) {
+        m_selection->set_selected(position);
+    }
+    m_view->activate_action("list.scroll-to-item", Glib::Variant<guint32>::create(position));
+}
+
+Glib::RefPtr<Gio::ListModel> SectionSidebar::create_child_model(
+    const Glib::RefPtr<Glib::ObjectBase>& item) const {
+    auto section = std::dynamic_pointer_cast<SectionRow>(item);
+    if (!section || !section->m_node || section->m_node->children.empty()) {
+        return {};
+    }
+    return rows_for_children(*section->m_node);
+}
+
+Glib::RefPtr<Gtk::TreeListRow> SectionSidebar::row_for(const core::SectionNode* node) const {
+    if (!node || !m_model) {
+        return {};
+    }
+
+    std::vector<const core::SectionNode*> chain;
+    for (const core::SectionNode* n = node; n && n->parent; n = n->parent) {
+        chain.push_back(n);
+    }
+    if (chain.empty()) {
+        return {};
+    }
+
+    auto row = m_model->get_child_row(chain.back()->index_in_parent);
+    for (auto it = chain.rbegin() + 1; row && it != chain.rend(); ++it) {
+        row->set_expanded(true);
+        row = row->get_child_row((*it)->index_in_parent);
+    }
+    return row;
+}
+}  // namespace ui
@@ -0,0 +1,49 @@
+#ifndef UI_SECTION_SIDEBAR_HPP
+#define UI_SECTION_SIDEBAR_HPP
+
+#include "core/section_tree.hpp"
+
+#include <gtkmm.h>
+
+#include <functional>
+#include <string>
+
+namespace ui {
+class SectionRow : public Glib::Object {
+public:
+    const core::SectionNode* m_node = nullptr;
+
+    static Glib::RefPtr<SectionRow> create(const core::SectionNode* node) {
+        return Glib::make_refptr_for_instance<SectionRow>(new SectionRow(node));
+    }
+
+protected:
+    explicit SectionRow(const core::SectionNode* node)
+        : m_node(node) {}
+};
+
+// Sidebar over a core::SectionTree. Child rows are only created when their
+// parent is expanded, and locating a section walks its ancestors only.
+class SectionSidebar {
+public:
+    SectionSidebar(const std::function<void(const std::string&)>& on_section_selected,
+                   const std::function<void(const std::string&)>& on_section_reset);
+
+    Gtk::ListView* widget() const;
+
+    void set_tree(const core::SectionTree* tree);
+    void expand(const std::string& full_path);
+    void select(const std::string& full_path);
+
+private:
+    Glib::RefPtr<Gio::ListModel> create_child_model(const Glib::RefPtr<Glib::ObjectBase>& item) const;
+    Glib::RefPtr<Gtk::TreeListRow> row_for(const core::SectionNode* node) const;
+
+    Gtk::ListView* m_view = nullptr;
+    Glib::RefPtr<Gtk::TreeListModel> m_model;
+    Glib::RefPtr<Gtk::SingleSelection> m_selection;
+    const core::SectionTree* m_tree = nullptr;
+};
+}  // namespace ui
+
+#endif
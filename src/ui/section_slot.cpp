@@ -0,0 +1,43 @@
+#include "ui/section_slot.hpp"
+
+namespace ui {
+SectionSlot::SectionSlot(int placeholder_height)
+    : m_placeholderHeight(placeholder_height) {
+    m_root = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
+    m_root->set_size_request(-1, m_placeholderHeight);
+}
+
+Gtk::Box* SectionSlot::widget() const {
+    return m_root;
+}
+
+bool SectionSlot::is_realized() const {
+    return m_content != nullptr;
+}
+
+void SectionSlot::realize(Gtk::Widget& content) {
+    if (m_content) {
+        return;
+    }
+
+    m_root->append(content);
+    m_root->set_size_request(-1, -1);
+    m_content = &content;
+}
+
+void SectionSlot::evict() {
+    if (!m_content) {
+        return;
+    }
+
+    const int height = m_root->get_height();
+    if (height > 0) {
+        m_placeholderHeight = height;
+    }
+
+    // The panel widgets are managed, so dropping them from the slot frees them.
+    m_root->remove(*m_content);
+    m_content = nullptr;
+    m_root->set_size_request(-1, m_placeholderHeight);
+}
+}  // namespace ui
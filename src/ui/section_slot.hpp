@@ -0,0 +1,27 @@
+#ifndef UI_SECTION_SLOT_HPP
+#define UI_SECTION_SLOT_HPP
+
+#include <gtkmm.h>
+
+namespace ui {
+// Fixed place in the content column for one section. The panel inside can be
+// built and dropped at will; while it is absent the slot keeps the height the
+// panel last had (or an estimate) so the scroll position does not jump.
+class SectionSlot {
+public:
+    explicit SectionSlot(int placeholder_height);
+
+    Gtk::Box* widget() const;
+    bool is_realized() const;
+
+    void realize(Gtk::Widget& content);
+    void evict();
+
+private:
+    Gtk::Box* m_root = nullptr;
+    Gtk::Widget* m_content = nullptr;
+    int m_placeholderHeight = 0;
+};
+}  // namespace ui
+
+#endif
@@ -0,0 +1,60 @@
+#include "ui/staged_changes_bar.hpp"
+
+#include <string>
+
+namespace ui {
+StagedChangesBar::StagedChangesBar(const std::function<void(bool)>& on_mode_changed,
+                                   const std::function<void()>& on_apply,
+                                   const std::function<void()>& on_discard) {
+    m_root = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL);
+    m_root->set_spacing(5);
+
+    m_toggle = Gtk::make_managed<Gtk::ToggleButton>();
+    m_toggle->set_icon_name("document-edit-symbolic");
+    m_toggle->set_tooltip_text("Stage changes and apply them together");
+
+    m_discard = Gtk::make_managed<Gtk::Button>("Discard");
+    m_discard->set_tooltip_text("Drop the pending changes");
+
+    auto applyContent = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::HORIZONTAL);
+    applyContent->set_spacing(6);
+    applyContent->append(*Gtk::make_managed<Gtk::Label>("Apply"));
+    m_badge = Gtk::make_managed<Gtk::Label>("0");
+    m_badge->add_css_class("pending-badge");
+    applyContent->append(*m_badge);
+
+    m_apply = Gtk::make_managed<Gtk::Button>();
+    m_apply->set_child(*applyContent);
+    m_apply->add_css_class("suggested-action");
+    m_apply->set_tooltip_text("Apply and save the pending changes");
+
+    m_toggle->signal_toggled().connect([this, on_mode_changed]() {
+        on_mode_changed(m_toggle->get_active());
+    });
+    m_apply->signal_clicked().connect(on_apply);
+    m_discard->signal_clicked().connect(on_discard);
+
+    m_root->append(*m_toggle);
+    m_root->append(*m_discard);
+    m_root->append(*m_apply);
+    set_pending(0);
+}
+
+Gtk::Box* StagedChangesBar::widget() const {
+    return m_root;
+}
+
+bool StagedChangesBar::staging() const {
+    return m_toggle->get_active();
+}
+
+void StagedChangesBar::set_pending(size_t count) {
+    m_badge->set_text(std::to_string(count));
+    // Leaving staged mode with changes pending still needs Apply or Discard.
+    const bool visible = staging() || count > 0;
+    m_apply->set_visible(visible);
+    m_discard->set_visible(visible);
+    m_apply->set_sensitive(count > 0);
+    m_discard->set_sensitive(count > 0);
+}
+}  // namespace ui
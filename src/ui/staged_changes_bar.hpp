@@ -0,0 +1,32 @@
+#ifndef UI_STAGED_CHANGES_BAR_HPP
+#define UI_STAGED_CHANGES_BAR_HPP
+
+#include <gtkmm.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace ui {
+// Header-bar controls for staged editing: a toggle for the mode, and Apply
+// (with a badge counting pending changes) and Discard buttons.
+class StagedChangesBar {
+public:
+    StagedChangesBar(const std::function<void(bool)>& on_mode_changed,
+                     const std::function<void()>& on_apply,
+                     const std::function<void()>& on_discard);
+
+    Gtk::Box* widget() const;
+
+    bool staging() const;
+    void set_pending(size_t count);
+
+private:
+    Gtk::Box* m_root = nullptr;
+    Gtk::ToggleButton* m_toggle = nullptr;
+    Gtk::Button* m_apply = nullptr;
+    Gtk::Button* m_discard = nullptr;
+    Gtk::Label* m_badge = nullptr;
+};
+}  // namespace ui
+
+#endif
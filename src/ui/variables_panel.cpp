@@ -3,7 +3,7 @@
 namespace ui {
 VariablesPanel::VariablesPanel(
     const std::string& section_path,
-    const Glib::RefPtr<Gio::ListStore<ConfigItem>>& section_store,
+    const Glib::RefPtr<Gio::ListModel>& section_model,
     const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_column_read,
     const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_column_edit,
     const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& bind_name,
@@ -16,7 +16,7 @@ VariablesPanel::VariablesPanel(
     label->set_halign(Gtk::Align::START);
     m_root->append(*label);
 
-    auto selectionModel = Gtk::SingleSelection::create(section_store);
+    auto selectionModel = Gtk::SingleSelection::create(section_model);
     auto columnView = Gtk::make_managed<Gtk::ColumnView>();
     columnView->set_model(selectionModel);
     columnView->add_css_class("data-table");
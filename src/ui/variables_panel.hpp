@@ -11,7 +11,7 @@ namespace ui {
 class VariablesPanel {
 public:
     VariablesPanel(const std::string& section_path,
-                   const Glib::RefPtr<Gio::ListStore<ConfigItem>>& section_store,
+                   const Glib::RefPtr<Gio::ListModel>& section_model,
                    const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_column_read,
                    const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& setup_column_edit,
                    const sigc::slot<void(const Glib::RefPtr<Gtk::ListItem>&)>& bind_name,
@@ -0,0 +1,34 @@
+#include "core/choice_list.hpp"
+
+#include <cassert>
+#include <string>
+
+int main() {
+    {
+        // Values are positions in the CSV; empty labels keep their index.
+        const core::ChoiceList list(" dwindle , ,master");
+        assert(list.size() == 2);
+        assert(list[0].value == "0" && list[0].label == "dwindle");
+        assert(list[1].value == "2" && list[1].label == "master");
+        assert(list.find("2") == 1);
+        assert(list.find("1") == core::ChoiceList::npos);
+    }
+
+    {
+        assert(core::ChoiceList("").empty());
+        assert(core::ChoiceList(",,").empty());
+        assert(core::ChoiceList("only").size() == 1);
+    }
+
+    {
+        // The same CSV yields the same shared list.
+        const auto first = core::shared_choice_list("a,b");
+        const auto second = core::shared_choice_list("a,b");
+        const auto other = core::shared_choice_list("a,c");
+        assert(first == second);
+        assert(first != other);
+        assert(other->entries()[1].label == "c");
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "core/description_index.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<size_t> options_of(const std::vector<core::SearchMatch>& matches) {
+    std::vector<size_t> options;
+    for (const auto& match : matches) {
+        options.push_back(match.option);
+    }
+    return options;
+}
+
+std::string saved(const core::DescriptionIndex& index) {
+    std::ostringstream out;
+    index.save(out);
+    return out.str();
+}
+
+bool loads(const std::string& bytes) {
+    core::DescriptionIndex index;
+    std::istringstream in(bytes);
+    return index.load(in);
+}
+
+void put_u32(std::string& bytes, size_t offset, uint32_t value) {
+    std::memcpy(&bytes[offset], &value, sizeof(value));
+}
+}  // namespace
+
+int main() {
+    const std::vector<std::string> descriptions = {
+        "Size of the border around windows.",
+        "Gaps between windows, and gaps from windows to the monitor edge.",
+        "Scale of the cursor on screen",
+        "If enabled, the logo is hidden",
+    };
+    const core::DescriptionIndex index(descriptions);
+    assert(index.option_count() == 4);
+
+    {
+        // Tokens are lowercased; stop words and single characters are not indexed.
+        assert(options_of(index.search("BORDER")) == std::vector<size_t>{0});
+        assert(index.search("the").empty());
+        assert(index.search("s").empty());
+        assert(index.search("").empty());
+    }
+
+    {
+        // Words match as prefixes, every word must match, and frequency ranks.
+        assert(options_of(index.search("sc")) == std::vector<size_t>{2});
+        assert(options_of(index.search("win")) == (std::vector<size_t>{1, 0}));
+        assert(options_of(index.search("gaps monitor")) == std::vector<size_t>{1});
+        assert(index.search("gaps cursor").empty());
+    }
+
+    {
+        // Saved and loaded, the index answers the same.
+        core::DescriptionIndex loaded;
+        std::istringstream in(saved(index));
+        assert(loaded.load(in));
+        assert(loaded.option_count() == index.option_count());
+        assert(loaded.term_count() == index.term_count());
+        assert(options_of(loaded.search("win")) == options_of(index.search("win")));
+    }
+
+    {
+        // Corrupt caches are rejected without touching the index. Layout of
+        // this one: magic, option and term counts, "alpha" and "beta" with
+        // their lengths, offsets 0 1 3, then three postings.
+        const core::DescriptionIndex small({"alpha beta", "beta"});
+        const std::string good = saved(small);
+        const size_t termCountOffset = 8 + sizeof(uint32_t);
+        const size_t firstTerm = termCountOffset + 2 * sizeof(uint32_t);
+        const size_t lastOffset = good.size() - 3 * 2 * sizeof(uint32_t) - sizeof(uint32_t);
+        assert(loads(good));
+
+        assert(!loads(""));
+        assert(!loads("not an index"));
+        assert(!loads(good.substr(0, good.size() - 1)));
+
+        // Counts past the end of the file are refused before allocating.
+        std::string terms = good;
+        put_u32(terms, termCountOffset, 0xffffffffu);
+        assert(!loads(terms));
+
+        std::string postings = good;
+        put_u32(postings, lastOffset, 0xfffffff0u);
+        assert(!loads(postings));
+
+        // Terms out of order would break the binary search.
+        std::string unsorted = good;
+        unsorted[firstTerm] = 'z';
+        assert(!loads(unsorted));
+
+        core::DescriptionIndex kept(descriptions);
+        std::istringstream in(terms);
+        assert(!kept.load(in));
+        assert(kept.option_count() == 4);
+        assert(options_of(kept.search("border")) == std::vector<size_t>{0});
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "features/device_schema.hpp"
+#include "option_fixtures.hpp"
+
+#include <cassert>
+#include <string>
+
+int main() {
+    SettingsSnapshot snapshot;
+    for (const char* name : {"general:border_size", "input:kb_layout", "input:repeat_rate",
+                             "input:follow_mouse", "input:sensitivity", "input:natural_scroll",
+                             "input:scroll_factor", "input:touchpad:natural_scroll",
+                             "input:touchpad:tap-to-click", "input:touchdevice:enabled",
+                             "input:touchdevice:output", "input:tablet:region_size",
+                             "input:virtualkeyboard:share_states"}) {
+        snapshot.options.push_back(make_option(name));
+    }
+
+    const features::DeviceSchema schema(snapshot);
+
+    {
+        // Keyboards take the keyboard options and borrow `enabled`.
+        const auto& options = schema.options(DeviceClass::Keyboard);
+        assert(options.size() == 3);
+        assert(options[0].name == "enabled");
+        assert(options[1].name == "kb_layout");
+        assert(options[1].option_index == 1);
+        assert(options[2].name == "repeat_rate");
+    }
+
+    {
+        // Pointers take the touchpad section too; the global option wins a
+        // shared name. Options a device block ignores are left out.
+        const auto& options = schema.options(DeviceClass::Pointer);
+        assert(options.size() == 5);
+        const auto* natural = schema.find(DeviceClass::Pointer, "natural_scroll");
+        assert(natural && natural->option_index == 5);
+        assert(schema.find(DeviceClass::Pointer, "tap-to-click"));
+        assert(!schema.find(DeviceClass::Pointer, "follow_mouse"));
+        assert(!schema.find(DeviceClass::Pointer, "border_size"));
+    }
+
+    {
+        assert(schema.options(DeviceClass::Touch).size() == 2);
+        assert(schema.find(DeviceClass::Touch, "output")->option_index == 10);
+        assert(schema.options(DeviceClass::Tablet).size() == 1);
+        assert(!schema.find(DeviceClass::Tablet, "share_states"));
+    }
+
+    {
+        // Nothing to index without input options.
+        const features::DeviceSchema empty{SettingsSnapshot{}};
+        assert(empty.options(DeviceClass::Pointer).empty());
+        assert(!empty.find(DeviceClass::Keyboard, "kb_layout"));
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "features/edit_history.hpp"
+
+#include <cassert>
+#include <string>
+#include <utility>
+
+namespace {
+using Assignment = std::pair<std::string, std::string>;
+}  // namespace
+
+int main() {
+    {
+        // Runtime steps of one drag merge into a single entry.
+        features::EditHistory history;
+        history.record("general:border_size", "1", "2", true);
+        history.record("general:border_size", "2", "3", true);
+        history.record("general:border_size", "3", "4");
+        assert(history.undo_size() == 1);
+
+        const OptionAssignments undo = history.undo();
+        assert(undo.size() == 1);
+        assert(undo[0] == Assignment("general:border_size", "1"));
+        assert(history.can_redo());
+
+        const OptionAssignments redo = history.redo();
+        assert(redo.size() == 1);
+        assert(redo[0] == Assignment("general:border_size", "4"));
+        assert(history.undo_size() == 1);
+        assert(!history.can_redo());
+    }
+
+    {
+        // Closed entries do not merge, and other options end the open one.
+        features::EditHistory history;
+        history.record("general:gaps_in", "5", "6");
+        history.record("general:gaps_in", "6", "7");
+        assert(history.undo_size() == 2);
+
+        history.record("decoration:rounding", "0", "4", true);
+        history.record("general:gaps_in", "7", "8", true);
+        assert(history.undo_size() == 4);
+    }
+
+    {
+        // A drag back to the start, and no-op changes, leave no entry.
+        features::EditHistory history;
+        history.record("general:border_size", "1", "3", true);
+        history.record("general:border_size", "3", "1");
+        history.record("general:gaps_in", "5", "5");
+        assert(!history.can_undo());
+    }
+
+    {
+        // A batch is one entry, reverted in reverse order.
+        features::EditHistory history;
+        history.record_batch({{"general:border_size", "1", "2"},
+                              {"general:gaps_in", "5", "5"},
+                              {"general:border_size", "2", "3"}});
+        assert(history.undo_size() == 1);
+
+        const OptionAssignments undo = history.undo();
+        assert(undo.size() == 2);
+        assert(undo[0] == Assignment("general:border_size", "2"));
+        assert(undo[1] == Assignment("general:border_size", "1"));
+
+        const OptionAssignments redo = history.redo();
+        assert(redo.size() == 2);
+        assert(redo[1] == Assignment("general:border_size", "3"));
+    }
+
+    {
+        // A new change drops the redo stack; capacity drops the oldest.
+        features::EditHistory history(3);
+        for (int i = 0; i < 5; ++i) {
+            history.record("general:gaps_in", std::to_string(i), std::to_string(i + 1));
+        }
+        assert(history.undo_size() == 3);
+        assert(history.undo()[0] == Assignment("general:gaps_in", "4"));
+        history.undo();
+        history.undo();
+        assert(!history.can_undo());
+        assert(history.undo().empty());
+        assert(history.redo_size() == 3);
+
+        history.redo();
+        history.record("general:gaps_in", "3", "9");
+        assert(!history.can_redo());
+        assert(history.undo_size() == 2);
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "core/event_ring.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+    using core::EventKind;
+    using core::EventRing;
+
+    {
+        auto ring = std::make_unique<EventRing>();
+        assert(ring->snapshot().empty());
+
+        const auto start = EventRing::Clock::now();
+        ring->push(EventKind::Keyword, "general:border_size", start, start + std::chrono::microseconds(5), true);
+        ring->push(EventKind::Devices, std::string(100, 'x'), start, false);
+
+        const auto events = ring->snapshot();
+        assert(events.size() == 2);
+        assert(events[0].sequence == 0);
+        assert(events[0].name == "general:border_size");
+        assert(events[0].kind == EventKind::Keyword);
+        assert(events[0].ok);
+        assert(events[0].duration_ns == 5000);
+        assert(events[1].name == std::string(EventRing::kMaxNameLength, 'x'));
+        assert(!events[1].ok);
+
+        assert(ring->snapshot(1).size() == 1);
+        assert(ring->snapshot(2).empty());
+    }
+
+    {
+        // Writers never block each other or the reader, and the reader only
+        // ever sees whole events.
+        auto ring = std::make_unique<EventRing>();
+        const auto start = EventRing::Clock::now();
+        std::atomic<bool> done{false};
+
+        std::thread reader([&]() {
+            while (!done) {
+                uint64_t last = 0;
+                bool first = true;
+                for (const auto& event : ring->snapshot()) {
+                    assert(first || event.sequence > last);
+                    assert(event.name == "runtime" || event.name == "persistent");
+                    assert(event.ok == (event.name == "runtime"));
+                    last = event.sequence;
+                    first = false;
+                }
+            }
+        });
+
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 4; ++t) {
+            writers.emplace_back([&ring, start, t]() {
+                const bool runtime = t % 2 == 0;
+                for (int i = 0; i < 50000; ++i) {
+                    ring->push(runtime ? EventKind::RuntimeUpdate : EventKind::PersistentUpdate,
+                               runtime ? "runtime" : "persistent", start, runtime);
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+
+        assert(ring->head() == 200000);
+        assert(ring->snapshot().size() == EventRing::kCapacity);
+        assert(ring->snapshot().front().sequence == 200000 - EventRing::kCapacity);
+    }
+
+    return 0;
+}
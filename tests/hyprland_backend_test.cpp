@@ -26,5 +26,34 @@ int main() {
         assert(hyprland::section_path_from_option_name("debug") == "");
     }
 
+    {
+        // Vec2 options carry their default as data.x and data.y.
+        const SettingsSnapshot snapshot = hyprland::parse_descriptions_json(R"([{
+            "value": "decoration:shadow:offset",
+            "description": "shadow's rendering offset.",
+            "type": 8,
+            "data": {"x": 0, "y": 1.5, "min_x": -250, "min_y": -250, "max_x": 250, "max_y": 250,
+                     "current": "2, 2", "explicit": true}
+        }])");
+        assert(snapshot.options.size() == 1);
+        assert(snapshot.options[0].default_value == "0, 1.5");
+        assert(snapshot.options[0].value == "2, 2");
+        assert(snapshot.options[0].has_vector_range);
+    }
+
+    {
+        // Grouped by class; switches and unnamed tablet tools are dropped.
+        const auto devices = hyprland::parse_devices_json(
+            R"({"mice": [{"address": "0x1", "name": "touchpad"}],)"
+            R"( "keyboards": [{"name": "kbd", "layout": "us"}],)"
+            R"( "tablets": [{"name": "pen"}, {"type": "tabletTool"}],)"
+            R"( "touch": [], "switches": [{"name": "lid"}]})");
+        assert(devices.size() == 3);
+        assert(devices[0].name == "kbd" && devices[0].device_class == DeviceClass::Keyboard);
+        assert(devices[1].name == "touchpad" && devices[1].device_class == DeviceClass::Pointer);
+        assert(devices[2].name == "pen" && devices[2].device_class == DeviceClass::Tablet);
+        assert(hyprland::parse_devices_json("not json").empty());
+    }
+
     return 0;
 }
@@ -0,0 +1,79 @@
+#include "core/metrics.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+int main() {
+    using core::LatencyHistogram;
+
+    {
+        // Buckets tile the whole range with no gaps or overlaps.
+        for (size_t i = 1; i < LatencyHistogram::kBucketCount; ++i) {
+            assert(LatencyHistogram::bucket_lowest(i) == LatencyHistogram::bucket_highest(i - 1) + 1);
+        }
+        assert(LatencyHistogram::bucket_index(UINT64_MAX) == LatencyHistogram::kBucketCount - 1);
+        assert(LatencyHistogram::bucket_highest(LatencyHistogram::kBucketCount - 1) == UINT64_MAX);
+
+        std::mt19937_64 rng(7);
+        for (int i = 0; i < 100000; ++i) {
+            const uint64_t value = rng() >> (rng() % 64);
+            const size_t index = LatencyHistogram::bucket_index(value);
+            assert(LatencyHistogram::bucket_lowest(index) <= value);
+            assert(value <= LatencyHistogram::bucket_highest(index));
+            // Relative bucket width stays within 1/16.
+            const uint64_t width = LatencyHistogram::bucket_highest(index) - LatencyHistogram::bucket_lowest(index);
+            assert(width <= value / LatencyHistogram::kSubBuckets);
+        }
+    }
+
+    {
+        LatencyHistogram histogram;
+        assert(histogram.quantile(0.5) == 0);
+        for (uint64_t value = 1; value <= 1000; ++value) {
+            histogram.record(value * 1000);
+        }
+        assert(histogram.count() == 1000);
+        assert(histogram.max() == 1000000);
+        const uint64_t p50 = histogram.quantile(0.50);
+        const uint64_t p99 = histogram.quantile(0.99);
+        assert(p50 >= 500000 && p50 <= 500000 + 500000 / 16);
+        assert(p99 >= 990000 && p99 <= 1000000);
+        assert(histogram.quantile(1.0) == 1000000);
+    }
+
+    {
+        // Concurrent recorders lose nothing.
+        LatencyHistogram histogram;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&histogram, t]() {
+                for (uint64_t i = 0; i < 50000; ++i) {
+                    histogram.record(i * (t + 1));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(histogram.count() == 200000);
+        assert(histogram.max() == 49999 * 4);
+    }
+
+    {
+        namespace metrics = core::metrics;
+        metrics::reset();
+        metrics::record(metrics::Operation::Keyword, metrics::Clock::now(), true);
+        metrics::record(metrics::Operation::Keyword, metrics::Clock::now(), false);
+        metrics::add(metrics::Counter::BytesRead, 512);
+        assert(metrics::latency(metrics::Operation::Keyword).count() == 2);
+        assert(metrics::failures(metrics::Operation::Keyword) == 1);
+        assert(metrics::counter(metrics::Counter::BytesRead) == 512);
+        assert(metrics::format_report().find("keyword") != std::string::npos);
+        assert(metrics::format_duration(1500000) == "1.50 ms");
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "core/numeric_codec.hpp"
+#include "core/value_codec.hpp"
+
+#include <cassert>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace {
+double random_double(std::mt19937_64& rng) {
+    // Mix raw bit patterns with values in the ranges options actually use.
+    if (rng() % 2 == 0) {
+        const uint64_t bits = rng();
+        double value = 0.0;
+        std::memcpy(&value, &bits, sizeof(value));
+        return std::isfinite(value) ? value : 0.0;
+    }
+    std::uniform_real_distribution<double> dist(-10000.0, 10000.0);
+    return dist(rng);
+}
+
+std::string random_text(std::mt19937_64& rng) {
+    static const char alphabet[] = "0123456789+-.,eExX \tinfa#";
+    std::string text(rng() % 12, ' ');
+    for (char& c : text) {
+        c = alphabet[rng() % (sizeof(alphabet) - 1)];
+    }
+    return text;
+}
+}
+
+int main() {
+    // Comma-decimal locales must not change how numbers are read or written.
+    if (std::setlocale(LC_ALL, "de_DE.UTF-8") == nullptr) {
+        std::setlocale(LC_ALL, "C");
+    }
+
+    {
+        assert(core::parse_number("0.5") == 0.5);
+        assert(core::parse_number("  +2 ") == 2.0);
+        assert(core::parse_number("-1e3") == -1000.0);
+        assert(!core::parse_number("0,5").has_value());
+        assert(!core::parse_number("").has_value());
+        assert(!core::parse_number("1.5x").has_value());
+        assert(!core::parse_number("inf").has_value());
+        assert(!core::parse_number("--1").has_value());
+
+        assert(core::parse_integer("42") == 42);
+        assert(!core::parse_integer("4.2").has_value());
+        assert(core::parse_leading_integer("3.9px") == 3);
+        assert(core::parse_leading_integer("-3.9") == -3);
+        assert(!core::parse_leading_integer("px").has_value());
+    }
+
+    {
+        assert(core::format_fixed<2>(0.5).view() == "0.5");
+        assert(core::format_fixed<2>(1.0).view() == "1");
+        assert(core::format_fixed<2>(0.125).view() == "0.12" || core::format_fixed<2>(0.125).view() == "0.13");
+        assert(core::format_fixed<2>(-0.001).view() == "0");
+        assert(core::format_fixed<0>(-0.4).view() == "0");
+        assert(core::format_fixed<6>(1e300).view() == core::format_shortest(1e300).view());
+        assert(core::format_shortest(-0.0).view() == "0");
+        assert(core::format_integer(-17).view() == "-17");
+        assert(core::format_range_value(3.7, false) == "3");
+        assert(core::format_vector_value(1.0, 2.5, false) == "1, 2.5");
+        assert(core::parse_vector_value("1,2") == std::make_pair(1.0, 2.0));
+        assert(core::parse_vector_value(" 1 , -2.5 ") == std::make_pair(1.0, -2.5));
+        assert(!core::parse_vector_value("1 2 3").has_value());
+    }
+
+    std::mt19937_64 rng(0x5eed);
+    for (int i = 0; i < 200000; ++i) {
+        const double value = random_double(rng);
+
+        // The shortest form reads back bit-exactly.
+        const auto shortest = core::format_shortest(value);
+        const auto reparsed = core::parse_number(shortest.view());
+        assert(reparsed.has_value() && *reparsed == value);
+
+        // Fixed output is stable once it has been rounded.
+        const auto fixed = core::format_fixed<2>(value);
+        const auto fixedValue = core::parse_number(fixed.view());
+        assert(fixedValue.has_value());
+        assert(core::format_fixed<2>(*fixedValue).view() == fixed.view());
+
+        const long long integer = static_cast<long long>(rng());
+        assert(core::parse_integer(core::format_integer(integer).view()) == integer);
+    }
+
+    for (int i = 0; i < 200000; ++i) {
+        // Arbitrary input never throws, and anything accepted formats back to
+        // something that parses to the same value.
+        const std::string text = random_text(rng);
+        if (auto parsed = core::parse_number(text)) {
+            assert(core::parse_number(core::format_shortest(*parsed).view()) == *parsed);
+        }
+        core::parse_leading_integer(text);
+        core::parse_vector_value(text);
+    }
+
+    return 0;
+}
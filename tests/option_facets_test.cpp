@@ -0,0 +1,116 @@
+#include "core/option_bitset.hpp"
+#include "features/option_facets.hpp"
+#include "option_fixtures.hpp"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<size_t> indices_of(const core::OptionBitset& bits) {
+    std::vector<size_t> indices;
+    bits.for_each([&indices](size_t index) { indices.push_back(index); });
+    return indices;
+}
+}  // namespace
+
+int main() {
+    {
+        // Bits past the size stay clear, across word boundaries.
+        core::OptionBitset bits(130, true);
+        assert(bits.count() == 130);
+        assert(!bits.test(130));
+        bits.set(200);
+        assert(bits.count() == 130);
+
+        bits.fill(false);
+        bits.set(0);
+        bits.set(64);
+        bits.set(129);
+        assert(indices_of(bits) == (std::vector<size_t>{0, 64, 129}));
+    }
+
+    {
+        core::OptionBitset a(100);
+        core::OptionBitset b(100);
+        a.set(3);
+        a.set(70);
+        b.set(70);
+        assert(b.is_subset_of(a));
+        assert(!a.is_subset_of(b));
+        assert(core::OptionBitset(100).is_subset_of(b));
+
+        core::OptionBitset both = core::OptionBitset::intersection(100, {&a, nullptr, &b});
+        assert(indices_of(both) == std::vector<size_t>{70});
+        assert(core::OptionBitset::intersection(100, {nullptr}).count() == 100);
+
+        b.set(5);
+        b |= a;
+        assert(indices_of(b) == (std::vector<size_t>{3, 5, 70}));
+        b &= a;
+        assert(indices_of(b) == (std::vector<size_t>{3, 70}));
+    }
+
+    SettingsSnapshot snapshot;
+    snapshot.options = {
+        make_option("general:border_size", 1, "2", "1", true),
+        make_option("general:gaps_in", 1, "5", "5"),
+        make_option("decoration:blur:enabled", 0, "true", "1"),
+        make_option("general:layout", 6, "master", "", true),
+        // descriptions gives vec2 options no default value.
+        make_option("decoration:shadow:offset", 8, "0 0", ""),
+        make_option("cursor:hotspot_padding", 8, "3 3", "1 1"),
+    };
+    snapshot.options[3].choice_values_csv = "dwindle,master";
+
+    features::OptionFacets facets;
+    facets.rebuild(snapshot);
+
+    {
+        // Choices and unparsable defaults have no default and are never
+        // counted as non-default.
+        assert(!facets.default_value(3));
+        assert(!facets.default_value(4));
+        assert(facets.default_value(5) && facets.default_value(5)->str() == "1, 1");
+        assert(facets.default_value(2)->str() == "true");
+        assert(indices_of(facets.non_default()) == (std::vector<size_t>{0, 5}));
+        assert(indices_of(facets.modified()) == (std::vector<size_t>{0, 3}));
+
+        facets.set_value(4, core::OptionValue::decode(8, "9 9"));
+        assert(!facets.non_default().test(4));
+    }
+
+    {
+        // New values move options in and out of the non-default facet.
+        facets.set_value(0, core::OptionValue::decode(1, "1"));
+        facets.set_value(1, core::OptionValue::decode(1, "6"));
+        assert(indices_of(facets.non_default()) == (std::vector<size_t>{1, 5}));
+        facets.set_modified(0, false);
+        assert(indices_of(facets.modified()) == std::vector<size_t>{3});
+    }
+
+    {
+        // Facets and search matches combine with AND.
+        assert(facets.sections() == (std::vector<std::string>{"cursor", "decoration", "general"}));
+
+        features::FacetSelection selection;
+        selection.section = "general";
+        assert(indices_of(facets.combine(selection, nullptr)) == (std::vector<size_t>{0, 1, 3}));
+
+        selection.value_type = 1;
+        assert(indices_of(facets.combine(selection, nullptr)) == (std::vector<size_t>{0, 1}));
+
+        selection.non_default_only = true;
+        assert(indices_of(facets.combine(selection, nullptr)) == std::vector<size_t>{1});
+
+        core::OptionBitset search(snapshot.options.size());
+        search.set(0);
+        assert(facets.combine(selection, &search).count() == 0);
+
+        selection = {};
+        selection.section = "missing";
+        assert(facets.combine(selection, nullptr).count() == 0);
+    }
+
+    return 0;
+}
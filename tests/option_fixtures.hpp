@@ -0,0 +1,22 @@
+#ifndef TESTS_OPTION_FIXTURES_HPP
+#define TESTS_OPTION_FIXTURES_HPP
+
+#include "core/models.hpp"
+
+#include <string>
+
+// A snapshot option as parse_descriptions_json would produce it. Tests that
+// only care about names can leave the rest at ConfigOptionData's defaults.
+inline ConfigOptionData make_option(const std::string& name, int type = -1, const std::string& value = "",
+                                    const std::string& default_value = "", bool set_by_user = false) {
+    ConfigOptionData option;
+    option.name = name;
+    option.value_type = type;
+    option.value = value;
+    option.default_value = default_value;
+    option.set_by_user = set_by_user;
+    option.section_path = name.substr(0, name.rfind(':'));
+    return option;
+}
+
+#endif
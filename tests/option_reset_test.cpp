@@ -0,0 +1,71 @@
+#include "features/option_facets.hpp"
+#include "features/option_reset.hpp"
+#include "option_fixtures.hpp"
+
+#include <cassert>
+#include <string>
+#include <utility>
+
+namespace {
+using Assignment = std::pair<std::string, std::string>;
+}  // namespace
+
+int main() {
+    SettingsSnapshot snapshot;
+    snapshot.options = {
+        make_option("general:border_size", 1, "2", "1"),
+        make_option("general:gaps_in", 1, "5", "5", true),
+        make_option("general:snap:enabled", 0, "1", "0"),
+        make_option("decoration:rounding", 1, "0", "0"),
+        make_option("general:layout", 6, "master", "", true),
+        make_option("generalx:value", 1, "3", "1"),
+        // A vec2 default descriptions did not provide, and one it did.
+        make_option("decoration:shadow:offset", 8, "4 4", "", true),
+        make_option("cursor:hotspot_padding", 8, "3 3", "0, 0"),
+    };
+    snapshot.options[4].choice_values_csv = "dwindle,master";
+
+    features::OptionFacets facets;
+    facets.rebuild(snapshot);
+
+    {
+        // Non-default and explicitly set options, never choices or options
+        // without a usable default.
+        const OptionAssignments all = features::reset_changes(snapshot, facets, nullptr);
+        assert(all.size() == 5);
+        assert(all[0] == Assignment("general:border_size", "1"));
+        assert(all[1] == Assignment("general:gaps_in", "5"));
+        assert(all[2] == Assignment("general:snap:enabled", "false"));
+        assert(all[3] == Assignment("generalx:value", "1"));
+        assert(all[4] == Assignment("cursor:hotspot_padding", "0, 0"));
+
+        const core::OptionBitset decoration = features::section_options(snapshot, "decoration");
+        assert(features::reset_changes(snapshot, facets, &decoration).empty());
+    }
+
+    {
+        // A section covers its nested sections but not a sibling sharing its prefix.
+        const core::OptionBitset general = features::section_options(snapshot, "general");
+        assert(general.count() == 4);
+        assert(!general.test(5));
+
+        const OptionAssignments changes = features::reset_changes(snapshot, facets, &general);
+        assert(changes.size() == 3);
+
+        const core::OptionBitset snap = features::section_options(snapshot, "general:snap");
+        assert(features::reset_changes(snapshot, facets, &snap).size() == 1);
+    }
+
+    {
+        // A single row, and a row already at its default.
+        core::OptionBitset row(snapshot.options.size());
+        row.set(3);
+        assert(features::reset_changes(snapshot, facets, &row).empty());
+
+        facets.set_value(3, core::OptionValue::decode(1, "6"));
+        const OptionAssignments changes = features::reset_changes(snapshot, facets, &row);
+        assert(changes.size() == 1 && changes[0] == Assignment("decoration:rounding", "0"));
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "core/option_search_index.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<size_t> options_of(const std::vector<core::SearchMatch>& matches) {
+    std::vector<size_t> options;
+    for (const auto& match : matches) {
+        options.push_back(match.option);
+    }
+    return options;
+}
+
+bool contains(const std::vector<size_t>& options, size_t option) {
+    return std::find(options.begin(), options.end(), option) != options.end();
+}
+}  // namespace
+
+int main() {
+    core::OptionSearchIndex index({
+        "general:border_size",
+        "general:gaps_in",
+        "decoration:blur:size",
+        "input:kb_layout",
+        "misc:disable_hyprland_logo",
+        "Decoration:Rounding",
+    });
+    assert(index.size() == 6);
+
+    {
+        // An exact short name ranks first, then prefixes of a short name.
+        const auto& matches = index.search("size");
+        assert(!matches.empty());
+        assert(matches[0].option == 2);
+        assert(contains(options_of(matches), 0));
+        for (size_t i = 1; i < matches.size(); ++i) {
+            assert(matches[i - 1].score >= matches[i].score);
+        }
+    }
+
+    {
+        // Fuzzy subsequences match, case and spaces are ignored.
+        assert(options_of(index.search("gpin")) == std::vector<size_t>{1});
+        assert(options_of(index.search("KB LAY")) == std::vector<size_t>{3});
+        assert(contains(options_of(index.search("rounding")), 5));
+
+        // A query of only spaces normalizes to nothing, like an empty one.
+        assert(core::OptionSearchIndex::normalize_query("KB LAY") == "kblay");
+        assert(core::OptionSearchIndex::normalize_query("   ").empty());
+        assert(index.search("   ").empty());
+    }
+
+    {
+        // The character mask rejects names missing a query character.
+        assert(index.search("zq").empty());
+        assert(index.search("size!").empty());
+    }
+
+    {
+        // Extending a query rescans only the previous matches and gives the
+        // same result as a fresh search.
+        index.search("bo");
+        const std::vector<size_t> extended = options_of(index.search("bord"));
+        core::OptionSearchIndex fresh({
+            "general:border_size",
+            "general:gaps_in",
+            "decoration:blur:size",
+            "input:kb_layout",
+            "misc:disable_hyprland_logo",
+            "Decoration:Rounding",
+        });
+        assert(extended == options_of(fresh.search("bord")));
+
+        // Shortening it searches everything again.
+        assert(options_of(index.search("b")).size() > extended.size());
+        assert(index.search("").empty());
+    }
+
+    return 0;
+}
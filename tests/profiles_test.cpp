@@ -0,0 +1,94 @@
+#include "features/option_facets.hpp"
+#include "features/profiles.hpp"
+#include "option_fixtures.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+bool contains(const OptionAssignments& options, const std::string& name, const std::string& value) {
+    return std::find(options.begin(), options.end(), std::make_pair(name, value)) != options.end();
+}
+}  // namespace
+
+int main() {
+    SettingsSnapshot snapshot;
+    snapshot.options = {
+        make_option("general:border_size", 1, "2", "1"),
+        make_option("general:gaps_in", 1, "5", "5"),
+        make_option("decoration:rounding", 1, "0", "0"),
+        make_option("general:layout", 6, "dwindle", ""),
+        // descriptions gives vec2 options no default value.
+        make_option("decoration:shadow:offset", 8, "4 4", ""),
+    };
+    snapshot.options[3].choice_values_csv = "dwindle,master";
+
+    std::unordered_map<std::string, size_t> indices;
+    std::unordered_map<std::string, core::OptionValue> values;
+    for (size_t i = 0; i < snapshot.options.size(); ++i) {
+        const auto& option = snapshot.options[i];
+        indices.emplace(option.name, i);
+        values.emplace(option.name, core::OptionValue::decode(option.value_type, option.value));
+    }
+    features::OptionFacets facets;
+    facets.rebuild(snapshot);
+
+    {
+        // Only what differs from the defaults is kept, plus choices and
+        // options whose default is unknown.
+        const features::Profile profile = features::capture_profile("current", snapshot, values, facets);
+        assert(profile.options.size() == 3);
+        assert(contains(profile.options, "general:border_size", "2"));
+        assert(contains(profile.options, "general:layout", "dwindle"));
+        assert(contains(profile.options, "decoration:shadow:offset", "4, 4"));
+
+        // Applying the current state changes nothing.
+        assert(features::profile_changes(profile, snapshot, indices, values, facets).empty());
+    }
+
+    {
+        features::Profile profile;
+        profile.name = "gaming";
+        profile.options = {
+            {"general:gaps_in", "10"},
+            {"general:layout", "master"},
+            {"decoration:rounding", "+0"},
+            {"misc:not_an_option", "1"},
+        };
+        const features::ProfileChanges changes =
+            features::profile_changes(profile, snapshot, indices, values, facets);
+        assert(changes.values.size() == 2);
+        assert(contains(changes.values, "general:gaps_in", "10"));
+        assert(contains(changes.values, "general:layout", "master"));
+        // Not in the profile, so back to its default. The vec2 option has no
+        // default to go back to and is left alone rather than blanked.
+        assert(changes.defaults.size() == 1);
+        assert(contains(changes.defaults, "general:border_size", "1"));
+    }
+
+    {
+        const auto directory = std::filesystem::temp_directory_path() /
+                               ("hyprland-settings-profiles-" + std::to_string(getpid()));
+        features::ProfileStore store(directory);
+        assert(store.names().empty());
+        assert(!store.save({"../escape", {}}));
+
+        features::Profile profile{"battery", {{"decoration:blur:enabled", "false"}, {"misc:vfr", "true"}}};
+        assert(store.save(profile));
+        assert(store.save({"presentation", {}}));
+        assert((store.names() == std::vector<std::string>{"battery", "presentation"}));
+
+        const auto loaded = store.load("battery");
+        assert(loaded && loaded->options == profile.options);
+        assert(store.remove("battery"));
+        assert(!store.load("battery"));
+
+        std::filesystem::remove_all(directory);
+    }
+
+    return 0;
+}
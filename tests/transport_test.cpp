@@ -0,0 +1,229 @@
+#include "config_io.hpp"
+#include "platform/fake_compositor.hpp"
+#include "platform/hyprland_backend.hpp"
+#include "platform/transport.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+std::string temp_path(const std::string& name) {
+    return "/tmp/hyprland-settings-" + std::to_string(getpid()) + "-" + name;
+}
+
+const char* kDescriptions = R"([{
+    "value": "general:border_size",
+    "description": "size of the border around windows",
+    "type": 1,
+    "flags": 0,
+    "data": {"value": 1, "min": 0, "max": 20, "current": 2, "explicit": true}
+}])";
+}
+
+int main() {
+    {
+        assert(hyprland::to_ipc_message({"descriptions", {}, true}) == "j/descriptions");
+        assert(hyprland::to_ipc_message({"keyword", {"general:border_size", "2"}}) ==
+               "keyword general:border_size 2");
+        assert(hyprland::to_hyprctl_command({"devices", {}, true}) == "hyprctl -j devices");
+    }
+
+    {
+        // Batched JSON replies arrive back to back.
+        const auto values = hyprland::split_json_values("{\"a\": \"}{\"}\n\n[1, {\"b\": 2}] {}");
+        assert(values.size() == 3);
+        assert(values[0] == "{\"a\": \"}{\"}");
+        assert(values[1] == "[1, {\"b\": 2}]");
+        assert(hyprland::split_json_values("{} no such option").empty());
+        assert(hyprland::split_json_values("{\"a\": 1").empty());
+    }
+
+    const std::string socketPath = temp_path("fake.sock");
+    const std::string replayPath = temp_path("replay.txt");
+    std::remove(replayPath.c_str());
+
+    hyprland::FakeCompositor::Options options;
+    options.latency = std::chrono::milliseconds(20);
+    hyprland::FakeCompositor compositor(options);
+    compositor.add_entries({
+        {"j/descriptions", {true, kDescriptions}},
+        {"j/devices", {true, R"({"mice": [{"name": "test-mouse"}], "keyboards": [{"name": "test-kbd"}]})"}},
+        {"keyword general:border_size oops", {false, "invalid value"}},
+        {"j/getoption general:border_size", {true, R"({"option": "general:border_size", "int": 3, "set": true})"}},
+        {"j/getoption general:gaps_out", {true, R"({"option": "general:gaps_out", "custom": "5 5 5 5", "set": false})"}},
+        {"j/getoption cursor:hotspot_padding", {true, R"({"option": "cursor:hotspot_padding", "vec2": [1.5, 2], "set": false})"}},
+    });
+    assert(compositor.start(socketPath));
+
+    {
+        // The backend end to end, recorded as it goes.
+        auto socket = std::make_shared<hyprland::SocketTransport>(socketPath);
+        HyprlandBackend backend(std::make_shared<hyprland::RecordingTransport>(socket, replayPath));
+
+        const auto start = std::chrono::steady_clock::now();
+        SettingsSnapshot snapshot = backend.load_snapshot();
+        assert(std::chrono::steady_clock::now() - start >= options.latency);
+
+        assert(snapshot.options.size() == 1);
+        assert(snapshot.options[0].value == "2");
+        assert(snapshot.available_devices.size() == 2);
+
+        assert(backend.apply_runtime_option("general:border_size", "3"));
+        assert(!backend.apply_runtime_option("general:border_size", "oops"));
+        assert(compositor.requests_served() == 4);
+    }
+
+    {
+        // Several options cost one batch request and one config write.
+        const std::string configPath = temp_path("hyprland.conf");
+        std::ofstream(configPath) << "# config\n";
+        setenv("HYPRLAND_SETTINGS_CONFIG", configPath.c_str(), 1);
+        HyprlandBackend backend(std::make_shared<hyprland::SocketTransport>(socketPath));
+
+        const size_t served = compositor.requests_served();
+        assert(backend.apply_persistent_options({{"general:border_size", "3"}, {"general:gaps_in", "5"}}));
+        assert(compositor.requests_served() == served + 1);
+
+        std::ifstream in(configPath);
+        const std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        assert(written.find("# config") == 0);
+        assert(written.find("gaps_in = 5") != std::string::npos);
+
+        // A rejected batch is replayed one by one to find the culprit.
+        std::vector<std::string> failed;
+        assert(!backend.apply_runtime_options({{"general:gaps_in", "4"}, {"general:border_size", "oops"}}, &failed));
+        assert(failed == std::vector<std::string>{"general:border_size"});
+        assert(compositor.requests_served() == served + 4);
+
+        unsetenv("HYPRLAND_SETTINGS_CONFIG");
+        std::remove(configPath.c_str());
+    }
+
+    {
+        // Reset drops the assignments in either form, and blocks left empty.
+        const std::string configPath = temp_path("reset.conf");
+        std::ofstream(configPath) << "# config\n"
+                                  << "general {\n"
+                                  << "    border_size = 3\n"
+                                  << "    gaps_in = 5\n"
+                                  << "}\n"
+                                  << "decoration {\n"
+                                  << "    blur {\n"
+                                  << "        size = 8\n"
+                                  << "    }\n"
+                                  << "}\n"
+                                  << "general:border_size = 4\n";
+        setenv("HYPRLAND_SETTINGS_CONFIG", configPath.c_str(), 1);
+        HyprlandBackend backend(std::make_shared<hyprland::SocketTransport>(socketPath));
+
+        const size_t served = compositor.requests_served();
+        assert(backend.reset_options({{"general:border_size", "1"}, {"decoration:blur:size", "8"}}));
+        assert(compositor.requests_served() == served + 1);
+
+        std::ifstream in(configPath);
+        const std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        assert(written == "# config\ngeneral {\n    gaps_in = 5\n}\n");
+
+        unsetenv("HYPRLAND_SETTINGS_CONFIG");
+        std::remove(configPath.c_str());
+    }
+
+    {
+        // A profile switch sets some options and resets others in one config
+        // write and one batch.
+        const std::string configPath = temp_path("switch.conf");
+        std::ofstream(configPath) << "general {\n"
+                                  << "    border_size = 3\n"
+                                  << "}\n";
+        setenv("HYPRLAND_SETTINGS_CONFIG", configPath.c_str(), 1);
+        HyprlandBackend backend(std::make_shared<hyprland::SocketTransport>(socketPath));
+
+        const size_t served = compositor.requests_served();
+        assert(backend.apply_changes({{"general:gaps_in", "5"}}, {{"general:border_size", "1"}}));
+        assert(compositor.requests_served() == served + 1);
+
+        std::ifstream in(configPath);
+        const std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        assert(written == "general {\n    gaps_in = 5\n}\n");
+
+        unsetenv("HYPRLAND_SETTINGS_CONFIG");
+        std::remove(configPath.c_str());
+    }
+
+    {
+        // Comments inside a removed block go with it, and braces may carry a
+        // trailing comment.
+        const std::string configPath = temp_path("comments.conf");
+        std::ofstream(configPath) << "decoration { # looks\n"
+                                  << "    # blur settings\n"
+                                  << "    blur {\n"
+                                  << "        # how far\n"
+                                  << "        size = 8\n"
+                                  << "\n"
+                                  << "    } # blur\n"
+                                  << "    rounding = 4 # corners\n"
+                                  << "} # decoration\n"
+                                  << "misc {\n"
+                                  << "    # kept\n"
+                                  << "    vfr = true\n"
+                                  << "}\n";
+        assert(ConfigIO::removeOptions(configPath, {"decoration:blur:size", "decoration:rounding"}));
+
+        std::ifstream in(configPath);
+        const std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        assert(written == "misc {\n    # kept\n    vfr = true\n}\n");
+        std::remove(configPath.c_str());
+    }
+
+    {
+        // Refreshing options costs one batch of getoption queries.
+        HyprlandBackend backend(std::make_shared<hyprland::SocketTransport>(socketPath));
+        const size_t served = compositor.requests_served();
+        const std::vector<OptionState> states =
+            backend.refresh_options({"general:border_size", "general:gaps_out", "cursor:hotspot_padding"});
+        assert(compositor.requests_served() == served + 1);
+        assert(states.size() == 3);
+        assert(states[0].name == "general:border_size" && states[0].value == "3" && states[0].set_by_user);
+        assert(states[1].value == "5 5 5 5" && !states[1].set_by_user);
+        assert(states[2].value == "1.5 2");
+
+        // An unknown option fails the batch; the others still come back.
+        const std::vector<OptionState> partial = backend.refresh_options({"general:border_size", "nope"});
+        assert(partial.size() == 1 && partial[0].name == "general:border_size");
+    }
+
+    compositor.stop();
+
+    {
+        // A recording replays to the same answers.
+        const auto entries = hyprland::read_replay_file(replayPath);
+        assert(entries.size() == 4);
+        assert(entries[0].message == "j/descriptions");
+        assert(entries[0].reply.body == kDescriptions);
+
+        hyprland::FakeCompositor replay;
+        assert(replay.load_replay_file(replayPath));
+        assert(replay.start(socketPath));
+        hyprland::SocketTransport transport(socketPath);
+        assert(transport.send({"descriptions", {}, true}).body == kDescriptions);
+        assert(!transport.send({"keyword", {"general:border_size", "oops"}}).ok);
+        assert(!transport.send({"version", {}}).ok);
+
+        const auto replies = transport.send_batch({
+            {"keyword", {"general:border_size", "3"}},
+            {"keyword", {"general:border_size", "oops"}},
+        });
+        assert(replies.size() == 2 && replies[0].ok && !replies[1].ok);
+    }
+
+    std::remove(replayPath.c_str());
+    return 0;
+}